@@ -5,6 +5,7 @@
 
 #include <Foundation/Universe.hpp>
 #include <Foundation/Systems/Text.hpp>
+#include <Foundation/Systems/Data.hpp>
 
 enum Op : uint8_t {
   /* Flow */
@@ -104,19 +105,45 @@ void CPU::execute(const CPU::ByteCode& code) {
 
       /* I/O */
       case WRITE:
-        this->universe->system<TextSystem>().send(port("out"), fmt::format("{}", pop()));
+        {
+          /* Stall while a receiver applies backpressure, the value is formatted once and only sent again where it didn't fit */
+          int16_t value = pop();
+          bool text = textOutput;
+          bool data = dataOutput || !text;
+          std::string formatted = text ? fmt::format("{}", value) : std::string {};
+
+          state = AWAITING_OUTPUT;
+          while (shouldRun && (data || text)) {
+            if (data) {
+              data = this->universe->system<DataSystem>().send(port("out"), value) == SendStatus::Full;
+            }
+            if (text) {
+              text = this->universe->system<TextSystem>().send(port("out"), formatted) == SendStatus::Full;
+            }
+            if (data || text) {
+              std::this_thread::yield();
+            }
+          }
+          state = NORMAL;
+        }
         break;
 
       case READ:
         {
-          std::optional<std::string> msg;
+          /* Binary values are taken as they are, text typed into a terminal is parsed */
+          std::optional<int16_t> value;
           state = AWAITING_INPUT;
           do {
-            msg = this->universe->system<TextSystem>().receive(port("in"));
-          } while (shouldRun && !msg);
+            if (auto d = this->universe->system<DataSystem>().receive(port("in"))) {
+              value = d->toInt();
+            }
+            else if (auto msg = this->universe->system<TextSystem>().receive(port("in"))) {
+              std::istringstream(*msg) >> a;
+              value = a;
+            }
+          } while (shouldRun && !value);
           state = NORMAL;
-          std::istringstream(*msg) >> a;
-          push(a);
+          push(value.value_or(0));
         }
         break;
 
@@ -180,6 +207,19 @@ void CPU::run(const ByteCode& code) {
 }
 
 void CPU::update() {
+  /*
+   * Data receivers get the value as a Datum, text-only receivers such as a
+   * plain terminal get it formatted. With both kinds on "out" it's sent on
+   * both systems, and a receiver whose edge carries both kinds gets it twice.
+   */
+  bool data = false;
+  bool text = false;
+  for (const Connection* edge : this->universe->connections.outgoing(port("out"))) {
+    data = data || edge->capabilities.data.enabled;
+    text = text || (edge->capabilities.text.enabled && !edge->capabilities.data.enabled);
+  }
+  dataOutput = data;
+  textOutput = text;
 }
 
 void CPU::render() {
@@ -218,6 +258,10 @@ void CPU::render() {
     case AWAITING_INPUT:
       ImGui::Text("State: AWAITING INPUT");
       break;
+
+    case AWAITING_OUTPUT:
+      ImGui::Text("State: AWAITING OUTPUT");
+      break;
   }
   ImGui::End();
 }
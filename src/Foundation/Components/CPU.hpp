@@ -18,6 +18,7 @@ struct CPU : public Component {
     HALTED,
     ILLEGAL,
     AWAITING_INPUT,
+    AWAITING_OUTPUT,
   };
 
   CPU(Universe* u)
@@ -27,12 +28,14 @@ struct CPU : public Component {
         .video = { false, 0.0f },
         .energy = { false, 0.0f },
         .text = { true },
+        .data = { true },
     }));
 
     addPort("out", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
         .video = { false, 0.0f },
         .energy = { false, 0.0f },
         .text = { true },
+        .data = { true },
     }));
   }
 
@@ -65,5 +68,8 @@ struct CPU : public Component {
   std::stack<int16_t> stack;
 
   std::atomic_bool shouldRun = false;
+  /* Kinds of receiver on "out", set by update. WRITE sends a Datum when neither is set */
+  std::atomic_bool dataOutput = false;
+  std::atomic_bool textOutput = false;
   std::thread evalThread;
 };
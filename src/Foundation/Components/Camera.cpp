@@ -0,0 +1,69 @@
+#include <Foundation/Components/Camera.hpp>
+
+#include <imgui.h>
+#include <fmt/format.h>
+
+#include <Foundation/Universe.hpp>
+#include <Foundation/Infrastructures/Wiring.hpp>
+#include <Foundation/Infrastructures/Wireless.hpp>
+#include <Foundation/Systems/Video.hpp>
+
+Camera::Camera(Universe* u)
+  : Component(u)
+{
+  addPort("video", new Antenna(100.0f, 40.0f, Capabilities {
+      .video = { true, 0.0f },
+      .energy = { false, 0.0f },
+      .text = { false },
+      .data = { false },
+  }));
+
+  addPort("energy", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 10.0f },
+      .text = { false },
+      .data = { false },
+  }));
+
+  debugger.addCommand("set_color", [this](float r, float g, float b) {
+    color = { r, g, b };
+  });
+
+  debugger.addCommand("get_color", [this]() {
+    return fmt::format("{} {} {}", color.r, color.g, color.b);
+  });
+
+  debugger.addCommand("set_freq", [this](float f) {
+    auto* a = dynamic_cast<Antenna*>(port("video"));
+    a->tune(f);
+  });
+
+  debugger.addCommand("get_freq", [this]() {
+    auto* a = dynamic_cast<Antenna*>(port("video"));
+    return fmt::format("{}", a->frequency);
+  });
+}
+
+void Camera::update() {
+  Component::update();
+
+  uint32_t pixel = Frame::pack(color);
+  if (!frame || frame->at(0, 0) != pixel) {
+    frame = std::make_shared<const Frame>(width, height, pixel);
+  }
+
+  universe->system<VideoSystem>().send(port("video"), frame);
+}
+
+void Camera::render() {
+  auto* a = dynamic_cast<Antenna*>(port("video"));
+
+  ImGui::SetNextWindowSize({ 256, 0 });
+  ImGui::Begin("Camera");
+  ImGui::ColorPicker3("Color", (float*)&color);
+  float frequency = a->frequency;
+  if (ImGui::SliderFloat("Frequency", &frequency, 40.0f, 50.0f)) {
+    a->tune(frequency);
+  }
+  ImGui::End();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+
+#include <glm/glm.hpp>
+
+#include <Foundation/Components/Component.hpp>
+#include <Foundation/Systems/Frame.hpp>
+
+class Camera : public Component {
+public:
+  explicit Camera(Universe* u);
+
+  void update() override;
+  void render() override;
+
+  std::string name() const override {
+    return "camera";
+  }
+
+  std::string defaultPort() const override {
+    return "video";
+  }
+
+  static constexpr uint32_t width = 640;
+  static constexpr uint32_t height = 480;
+
+  glm::vec3 color;
+  /* Last frame sent, reused while the colour doesn't change */
+  FramePtr frame;
+};
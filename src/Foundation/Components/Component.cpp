@@ -15,17 +15,30 @@ Component::Component(Universe* u)
       .video = { false, 0.0f },
       .energy = { false, 0.0f },
       .text = { true },
+      .data = { true },
   }));
 }
 
 Component::~Component() {
-  auto pred = [this](const Connection& c) {
-    return c.from->component == this || c.to->component == this;
-  };
+  for (auto& pair : ports) {
+    universe->connections.erase(pair.second.get());
+    universe->connections.removed(pair.second.get());
+
+    for (auto& system : universe->systems) {
+      system->detach(pair.second.get());
+    }
+  }
+}
 
-  auto beg = universe->connections.begin();
-  auto end = universe->connections.end();
-  universe->connections.erase(std::remove_if(beg, end, pred), end);
+void Component::move(glm::vec2 p) {
+  if (p == this->position) {
+    return;
+  }
+
+  this->position = p;
+  for (auto& pair : ports) {
+    universe->connections.moved(pair.second.get());
+  }
 }
 
 void Component::addPort(const std::string& name, Endpoint* p) {
@@ -26,6 +26,9 @@ struct Component {
   Endpoint* port(const std::string& id);
   std::string nameOf(const Endpoint* p);
 
+  /* Sets position and tells infrastructures that every port moved */
+  void move(glm::vec2 p);
+
   virtual std::vector<std::pair<float, Endpoint*>> redistributeEnergy(Endpoint *port) { return {}; };
 
   Universe* universe = nullptr;
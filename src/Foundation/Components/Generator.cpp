@@ -0,0 +1,48 @@
+#include <Foundation/Components/Generator.hpp>
+
+#include <imgui.h>
+
+#include <Foundation/Universe.hpp>
+#include <Foundation/Infrastructures/Wiring.hpp>
+#include <Foundation/Systems/Energy.hpp>
+
+Generator::Generator(Universe* u)
+  : Component(u)
+  , history(256, 0)
+  , random { u->seed }
+  , stream { u->components.size() }
+{
+  addPort("energy", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 100.0f },
+      .text = { true },
+      .data = { false }
+  }));
+}
+
+void Generator::update() {
+  Component::update();
+
+  noise = (Philox::toFloat(random(Philox::counter(ticks++, stream))[0]) - 0.5f) * 10.0f;
+  this->universe->system<EnergySystem>().produce(port("energy"), power + noise);
+  history.push_back(power + noise);
+
+  while (history.size() > 256) {
+    history.erase(history.begin());
+  }
+}
+
+void Generator::render() {
+  ImGui::SetNextWindowSize({ 256.0f, 0.0f });
+  ImGui::Begin("Generator");
+
+  ImGui::PushItemWidth(-1);
+  ImGui::SliderFloat("##power", &power, 0.0f, 100.0f);
+  ImGui::PopItemWidth();
+
+  ImGui::PushItemWidth(-1);
+  ImGui::PlotLines("##history", history.data(), history.size(), 0, nullptr, 0.0f, 100.0f);
+  ImGui::PopItemWidth();
+
+  ImGui::End();
+}
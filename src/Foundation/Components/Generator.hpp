@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Foundation/Components/Component.hpp>
+#include <Util/Philox.hpp>
+
+class Generator : public Component {
+public:
+  explicit Generator(Universe* u);
+
+  void update() override;
+  void render() override;
+
+  std::string name() const override {
+    return "generator";
+  }
+
+  std::string defaultPort() const override {
+    return "energy";
+  }
+
+  float power = 50.0f;
+  float noise = 0.0f;
+  std::vector<float> history;
+
+private:
+  /* Noise is keyed by (universe seed, update count, order of creation) */
+  Philox random;
+  uint64_t stream;
+  uint64_t ticks = 0;
+};
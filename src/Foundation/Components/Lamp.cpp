@@ -0,0 +1,34 @@
+#include <Foundation/Components/Lamp.hpp>
+
+#include <imgui.h>
+
+#include <Foundation/Universe.hpp>
+#include <Foundation/Infrastructures/Wiring.hpp>
+#include <Foundation/Systems/Energy.hpp>
+
+Lamp::Lamp(Universe* u)
+  : Component(u)
+  , id { ++counter }
+{
+  addPort("energy", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 10.0f },
+      .text = { true },
+      .data = { false },
+  }));
+}
+
+void Lamp::update() {
+  Component::update();
+
+  float energy = this->universe->system<EnergySystem>().consume(port("energy"), 10.0f);
+  satisfaction = energy / 10.0f;
+}
+
+void Lamp::render() {
+  ImGui::PushStyleColor(ImGuiCol_WindowBg, (ImU32)ImColor(satisfaction, satisfaction, 0.0f));
+  ImGui::SetNextWindowContentSize({ 64, 64 });
+  ImGui::Begin(name().c_str(), nullptr, ImGuiWindowFlags_NoResize);
+  ImGui::End();
+  ImGui::PopStyleColor();
+}
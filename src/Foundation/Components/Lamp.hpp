@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <Foundation/Components/Component.hpp>
+
+class Lamp : public Component {
+public:
+  explicit Lamp(Universe* u);
+
+  void update() override;
+  void render() override;
+
+  std::string name() const override {
+    return fmt::format("lamp{}", id);
+  }
+
+  std::string defaultPort() const override {
+    return "energy";
+  }
+
+  float satisfaction = 0.0f;
+
+  static inline size_t counter = 0;
+  size_t id = 0;
+};
@@ -0,0 +1,83 @@
+#include <Foundation/Components/Monitor.hpp>
+
+#include <imgui.h>
+
+#include <Foundation/Universe.hpp>
+#include <Foundation/Infrastructures/Wiring.hpp>
+#include <Foundation/Infrastructures/Wireless.hpp>
+#include <Foundation/Systems/Video.hpp>
+#include <Foundation/Systems/Text.hpp>
+#include <Foundation/Systems/Data.hpp>
+
+Monitor::Monitor(Universe* u)
+  : Component(u)
+{
+  this->addPort("video", new Antenna(200.0f, 42.0f, Capabilities {
+      .video = { true, 0.0f },
+      .energy = { false, 0.0f },
+      .text = { false },
+      .data = { false },
+  }));
+
+  this->addPort("data", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { false, 0.0f },
+      .text = { true },
+      .data = { true },
+  }));
+
+  this->addPort("energy", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 10.0f },
+      .text = { false },
+      .data = { false },
+  }));
+
+  this->debugger.addCommand("clear", [this] {
+    messages.clear();
+  });
+}
+
+void Monitor::update() {
+  Component::update();
+
+  this->frame = this->universe->system<VideoSystem>().receive(port("video"));
+
+  this->universe->system<TextSystem>().receiveAll(port("data"), this->messages);
+  this->universe->system<DataSystem>().drain(port("data"), [this](const Datum& d) {
+    this->messages.push_back(toString(d));
+  });
+
+  while (this->messages.size() > history) {
+    this->messages.pop_front();
+  }
+}
+
+void Monitor::render() {
+  ImGui::PushStyleColor(ImGuiCol_WindowBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f));
+  ImGui::SetNextWindowContentSize({ 128, 128 });
+  ImGui::Begin("Monitor", nullptr, ImGuiWindowFlags_NoResize);
+
+  /* Downsampled preview behind the text, pixels already are ImU32 */
+  if (this->frame && this->frame->size() != 0) {
+    constexpr uint32_t columns = 32;
+    constexpr uint32_t rows = 32;
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImVec2 cell { 128.0f / columns, 128.0f / rows };
+    ImDrawList* draw = ImGui::GetWindowDrawList();
+
+    for (uint32_t y = 0; y < rows; y++) {
+      for (uint32_t x = 0; x < columns; x++) {
+        uint32_t pixel = this->frame->at(x * this->frame->width / columns, y * this->frame->height / rows);
+        ImVec2 min { origin.x + x * cell.x, origin.y + y * cell.y };
+        draw->AddRectFilled(min, { min.x + cell.x, min.y + cell.y }, pixel);
+      }
+    }
+  }
+
+  for (auto& msg : messages) {
+    ImGui::Text("%s", msg.c_str());
+  }
+  ImGui::End();
+  ImGui::PopStyleColor();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <deque>
+#include <string>
+
+#include <glm/glm.hpp>
+
+#include <Foundation/Components/Component.hpp>
+#include <Foundation/Systems/Frame.hpp>
+
+class Monitor : public Component {
+public:
+  explicit Monitor(Universe* u);
+
+  void update() override;
+  void render() override;
+
+  std::string name() const override {
+    return "monitor";
+  }
+
+  std::string defaultPort() const override {
+    return "data";
+  }
+
+  /* Oldest messages are forgotten beyond this */
+  static constexpr size_t history = 64;
+
+  /* Frame currently shown, null while nothing is received */
+  FramePtr frame;
+  std::deque<std::string> messages;
+};
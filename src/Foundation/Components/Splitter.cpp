@@ -0,0 +1,39 @@
+#include <Foundation/Components/Splitter.hpp>
+
+#include <Foundation/Universe.hpp>
+#include <Foundation/Infrastructures/Wiring.hpp>
+
+Splitter::Splitter(Universe* u)
+  : Component(u)
+{
+  addPort("a", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 20.0f },
+      .text = { false },
+      .data = { false },
+  }));
+
+  addPort("b", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 20.0f },
+      .text = { false },
+      .data = { false },
+  }));
+
+  addPort("c", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 20.0f },
+      .text = { false },
+      .data = { false },
+  }));
+}
+
+std::vector<std::pair<float, Endpoint*>> Splitter::redistributeEnergy(Endpoint* p) {
+  std::vector<std::pair<float, Endpoint*>> neighbours;
+
+  if (p != port("a")) { neighbours.emplace_back(0.5f, port("a")); }
+  if (p != port("b")) { neighbours.emplace_back(0.5f, port("b")); }
+  if (p != port("c")) { neighbours.emplace_back(0.5f, port("c")); }
+
+  return neighbours;
+}
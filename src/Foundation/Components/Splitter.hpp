@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Foundation/Components/Component.hpp>
+
+class Splitter : public Component {
+public:
+  explicit Splitter(Universe* u);
+
+  void render() override { }
+
+  std::vector<std::pair<float, Endpoint*>> redistributeEnergy(Endpoint* p) override;
+
+  std::string name() const override {
+    return "splitter";
+  }
+
+  std::string defaultPort() const override {
+    return "a";
+  }
+};
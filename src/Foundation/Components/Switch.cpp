@@ -0,0 +1,49 @@
+#include <Foundation/Components/Switch.hpp>
+
+#include <imgui.h>
+
+#include <Foundation/Universe.hpp>
+#include <Foundation/Infrastructures/Wiring.hpp>
+#include <Foundation/Systems/Energy.hpp>
+
+Switch::Switch(Universe* u)
+  : Component(u)
+{
+  addPort("a", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 20.0f },
+      .text = { false },
+      .data = { false },
+  }));
+
+  addPort("b", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
+      .video = { false, 0.0f },
+      .energy = { true, 20.0f },
+      .text = { false },
+      .data = { false },
+  }));
+
+  debugger.addCommand("toggle", [this] {
+    toggle = !toggle;
+    this->universe->system<EnergySystem>().invalidate();
+  });
+}
+
+void Switch::render() {
+  ImGui::Begin("Switch");
+  if (ImGui::Checkbox("Toggle", &toggle)) {
+    this->universe->system<EnergySystem>().invalidate();
+  }
+  ImGui::End();
+}
+
+std::vector<std::pair<float, Endpoint*>> Switch::redistributeEnergy(Endpoint* p) {
+  std::vector<std::pair<float, Endpoint*>> neighbours;
+
+  if (toggle) {
+    if (p != port("a")) { neighbours.emplace_back(1.0f, port("a")); }
+    if (p != port("b")) { neighbours.emplace_back(1.0f, port("b")); }
+  }
+
+  return neighbours;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Foundation/Components/Component.hpp>
+
+class Switch : public Component {
+public:
+  explicit Switch(Universe* u);
+
+  void render() override;
+
+  std::vector<std::pair<float, Endpoint*>> redistributeEnergy(Endpoint* p) override;
+
+  std::string name() const override {
+    return "switch";
+  }
+
+  std::string defaultPort() const override {
+    return "a";
+  }
+
+  bool toggle = true;
+};
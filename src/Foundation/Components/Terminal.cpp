@@ -4,13 +4,22 @@
 
 #include <Foundation/Universe.hpp>
 #include <Foundation/Systems/Text.hpp>
+#include <Foundation/Systems/Data.hpp>
 
 void Terminal::update() {
-  while (auto s = this->universe->system<TextSystem>().receive(port("debug"))) {
-    messages.push_back(*s);
+  size_t received = this->universe->system<TextSystem>().receiveAll(port("debug"), messages);
+  received += this->universe->system<DataSystem>().drain(port("debug"), [this](const Datum& d) {
+    messages.push_back(toString(d));
+  });
+
+  if (received > 0) {
     newMessage = true;
   }
 
+  while (messages.size() > history) {
+    messages.pop_front();
+  }
+
   Component::update();
 }
 
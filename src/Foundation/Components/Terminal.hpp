@@ -16,6 +16,9 @@ public:
   }
 
 private:
+  /* Oldest messages are forgotten beyond this */
+  static constexpr size_t history = 512;
+
   bool newMessage = false;
   char buf[256] {};
   std::list<std::string> messages;
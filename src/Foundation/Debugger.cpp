@@ -18,8 +18,11 @@ Debugger::Debugger(Component* c, std::string portName)
 }
 
 void Debugger::update() {
-  while (auto s = component->universe->system<TextSystem>().receive(component->port(port))) {
-    std::istringstream iss(*s);
+  auto& text = component->universe->system<TextSystem>();
+  Endpoint* endpoint = component->port(port);
+
+  text.drain(endpoint, [&](std::string_view s) {
+    std::istringstream iss { std::string { s } };
 
     std::vector<std::string> tokens {
         std::istream_iterator<std::string>{iss},
@@ -32,16 +35,16 @@ void Debugger::update() {
           auto res = commands[tokens[0]].callback({ ++tokens.begin(), tokens.end() });
 
           if (res) {
-            component->universe->system<TextSystem>().send(component->port(port), *res);
+            text.send(endpoint, *res);
           }
         }
         else {
-          component->universe->system<TextSystem>().send(component->port(port), fmt::format("Unknown command '{}'", tokens[0]));
+          text.send(endpoint, fmt::format("Unknown command '{}'", tokens[0]));
         }
       }
       catch (std::runtime_error& e) {
-        component->universe->system<TextSystem>().send(component->port(port), e.what());
+        text.send(endpoint, e.what());
       }
     }
-  }
+  });
 }
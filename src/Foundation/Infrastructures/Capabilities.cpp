@@ -12,8 +12,14 @@ Capabilities Capabilities::combine(const Capabilities& a, const Capabilities& b)
           a.energy.enabled && b.energy.enabled,
           std::min(a.energy.throughput, b.energy.throughput),
       },
+      /* Queues are per endpoint, mailboxes read them from the port and never from the edge */
       {
           a.text.enabled && b.text.enabled,
+          {},
+      },
+      {
+          a.data.enabled && b.data.enabled,
+          {},
       },
   };
 }
@@ -21,3 +27,16 @@ Capabilities Capabilities::combine(const Capabilities& a, const Capabilities& b)
 Capabilities Capabilities::operator*(const Capabilities& other) const {
   return Capabilities::combine(*this, other);
 }
+
+bool Capabilities::operator==(const Capabilities& other) const {
+  return video.enabled == other.video.enabled
+      && video.errorRate == other.video.errorRate
+      && energy.enabled == other.energy.enabled
+      && energy.throughput == other.energy.throughput
+      && text.enabled == other.text.enabled
+      && data.enabled == other.data.enabled;
+}
+
+bool Capabilities::operator!=(const Capabilities& other) const {
+  return !(*this == other);
+}
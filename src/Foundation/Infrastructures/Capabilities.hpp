@@ -1,8 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <limits>
 
 struct Capabilities {
+  /* What a full message queue does with another message */
+  enum class Overflow : uint8_t {
+    Block,
+    DropOldest,
+    DropNewest,
+  };
+
+  /* Message queue of a port, only meaningful on endpoints and left default on connections */
+  struct Queue {
+    uint32_t capacity = 256;
+    Overflow overflow = Overflow::Block;
+  };
+
   struct {
     bool enabled = true;
     float errorRate = 0.0f;
@@ -15,9 +29,18 @@ struct Capabilities {
 
   struct {
     bool enabled = true;
+    Queue queue;
   } text;
 
+  struct {
+    bool enabled = true;
+    Queue queue;
+  } data;
+
   static Capabilities combine(const Capabilities& a, const Capabilities& b);
 
   Capabilities operator*(const Capabilities& other) const ;
+
+  bool operator==(const Capabilities& other) const;
+  bool operator!=(const Capabilities& other) const;
 };
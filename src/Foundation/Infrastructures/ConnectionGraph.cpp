@@ -0,0 +1,124 @@
+#include <Foundation/Infrastructures/ConnectionGraph.hpp>
+
+#include <algorithm>
+
+Connection* ConnectionGraph::find(Endpoint* from, Endpoint* to) {
+  auto it = this->byEndpoints.find({ from, to });
+  if (it == this->byEndpoints.end()) {
+    return nullptr;
+  }
+  return &*it->second;
+}
+
+Connection& ConnectionGraph::emplace(Endpoint* from, Endpoint* to, Capabilities capabilities, Infrastructure* author) {
+  auto it = this->connections.emplace(this->connections.end(), from, to, capabilities, author);
+  it->id = this->nextId++;
+
+  this->byEndpoints.emplace(Key { from, to }, it);
+  this->outgoingEdges[from].push_back(&*it);
+  this->incomingEdges[to].push_back(&*it);
+
+  for (auto* listener : this->listeners) {
+    listener->connected(*it);
+  }
+
+  return *it;
+}
+
+void ConnectionGraph::update(Connection& connection, Capabilities capabilities) {
+  if (connection.capabilities == capabilities) {
+    return;
+  }
+
+  connection.capabilities = capabilities;
+
+  for (auto* listener : this->listeners) {
+    listener->changed(connection);
+  }
+}
+
+bool ConnectionGraph::erase(Endpoint* from, Endpoint* to) {
+  auto it = this->byEndpoints.find({ from, to });
+  if (it == this->byEndpoints.end()) {
+    return false;
+  }
+
+  Connection* connection = &*it->second;
+
+  for (auto* listener : this->listeners) {
+    listener->disconnected(*connection);
+  }
+
+  unlink(this->outgoingEdges, from, connection);
+  unlink(this->incomingEdges, to, connection);
+
+  this->connections.erase(it->second);
+  this->byEndpoints.erase(it);
+
+  return true;
+}
+
+void ConnectionGraph::erase(Endpoint* endpoint) {
+  /* Copy, erasing modifies the adjacency lists */
+  std::vector<Connection*> outs = this->outgoing(endpoint);
+  std::vector<Connection*> ins = this->incoming(endpoint);
+
+  for (Connection* c : outs) {
+    this->erase(c->from, c->to);
+  }
+  for (Connection* c : ins) {
+    this->erase(c->from, c->to);
+  }
+}
+
+void ConnectionGraph::subscribe(ConnectionListener* listener) {
+  this->listeners.push_back(listener);
+
+  for (Connection& c : this->connections) {
+    listener->connected(c);
+  }
+}
+
+void ConnectionGraph::unsubscribe(ConnectionListener* listener) {
+  this->listeners.erase(std::remove(this->listeners.begin(), this->listeners.end(), listener), this->listeners.end());
+}
+
+void ConnectionGraph::moved(Endpoint* endpoint) {
+  for (auto* listener : this->listeners) {
+    listener->moved(*endpoint);
+  }
+}
+
+void ConnectionGraph::removed(Endpoint* endpoint) {
+  for (auto* listener : this->listeners) {
+    listener->removed(*endpoint);
+  }
+}
+
+const std::vector<Connection*>& ConnectionGraph::outgoing(Endpoint* endpoint) const {
+  static const std::vector<Connection*> none;
+
+  auto it = this->outgoingEdges.find(endpoint);
+  return it == this->outgoingEdges.end() ? none : it->second;
+}
+
+const std::vector<Connection*>& ConnectionGraph::incoming(Endpoint* endpoint) const {
+  static const std::vector<Connection*> none;
+
+  auto it = this->incomingEdges.find(endpoint);
+  return it == this->incomingEdges.end() ? none : it->second;
+}
+
+void ConnectionGraph::unlink(Adjacency& adjacency, Endpoint* endpoint, Connection* connection) {
+  auto it = adjacency.find(endpoint);
+  if (it == adjacency.end()) {
+    return;
+  }
+
+  auto& edges = it->second;
+  edges.erase(std::find(edges.begin(), edges.end(), connection));
+
+  if (edges.empty()) {
+    adjacency.erase(it);
+  }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <Foundation/Infrastructures/Infrastructure.hpp>
+#include <Util/Hash.hpp>
+
+/*
+ * Notified by ConnectionGraph whenever the topology changes: connections
+ * appear, disappear or change capabilities, and endpoints appear, move or
+ * are destroyed. Infrastructures react to endpoint events instead of
+ * rescanning every frame.
+ */
+class ConnectionListener {
+public:
+  virtual ~ConnectionListener() = default;
+
+  virtual void connected(Connection& edge) { }
+  virtual void disconnected(Connection& edge) { }
+  virtual void changed(Connection& edge) { }
+
+  /* Endpoint was added, moved or retuned, so the connections it should have may differ */
+  virtual void moved(Endpoint& endpoint) { }
+  /* Endpoint is being destroyed, its connections are already erased */
+  virtual void removed(Endpoint& endpoint) { }
+};
+
+/*
+ * Owns every Connection in the universe. Connections live in a list so
+ * pointers handed out stay valid until the connection itself is erased,
+ * and are indexed by (from, to) and by endpoint in both directions.
+ */
+class ConnectionGraph {
+  using Storage = std::list<Connection>;
+public:
+  using iterator = Storage::iterator;
+  using const_iterator = Storage::const_iterator;
+
+  Connection* find(Endpoint* from, Endpoint* to);
+
+  /* Adds a new connection, there must not be one between from and to yet */
+  Connection& emplace(Endpoint* from, Endpoint* to, Capabilities capabilities, Infrastructure* author);
+
+  /* Replaces the capabilities of an existing connection */
+  void update(Connection& connection, Capabilities capabilities);
+
+  bool erase(Endpoint* from, Endpoint* to);
+  /* Erases every connection starting or ending in endpoint */
+  void erase(Endpoint* endpoint);
+
+  const std::vector<Connection*>& outgoing(Endpoint* endpoint) const;
+  const std::vector<Connection*>& incoming(Endpoint* endpoint) const;
+
+  iterator begin() { return connections.begin(); }
+  iterator end() { return connections.end(); }
+  const_iterator begin() const { return connections.begin(); }
+  const_iterator end() const { return connections.end(); }
+
+  size_t size() const { return connections.size(); }
+  bool empty() const { return connections.empty(); }
+
+  void subscribe(ConnectionListener* listener);
+  void unsubscribe(ConnectionListener* listener);
+
+  /* Endpoint events, published by whoever changes the endpoint */
+  void moved(Endpoint* endpoint);
+  void removed(Endpoint* endpoint);
+
+private:
+  using Key = std::pair<Endpoint*, Endpoint*>;
+  using Adjacency = std::unordered_map<Endpoint*, std::vector<Connection*>>;
+
+  static void unlink(Adjacency& adjacency, Endpoint* endpoint, Connection* connection);
+
+  Storage connections;
+  uint64_t nextId = 0;
+
+  std::unordered_map<Key, iterator, PairHash> byEndpoints;
+  Adjacency outgoingEdges;
+  Adjacency incomingEdges;
+
+  std::vector<ConnectionListener*> listeners;
+};
@@ -14,27 +14,21 @@ void Infrastructure::connect(Endpoint* from, Endpoint* to, Capabilities capabili
   Capabilities newCapabilities = from->capabilities * capabilities * to->capabilities;
 
   if (Connection* c = connection(from, to)) {
-    c->capabilities = newCapabilities;
+    universe->connections.update(*c, newCapabilities);
   }
   else {
-    universe->connections.emplace_back(from, to, newCapabilities, this);
+    universe->connections.emplace(from, to, newCapabilities, this);
   }
 }
 
 void Infrastructure::disconnect(Endpoint* from, Endpoint* to) {
-  auto pred = [&](const Connection& c) {
-    return c.author == this && c.from == from && c.to == to;
-  };
+  Connection* c = connection(from, to);
 
-  auto pos = std::remove_if(universe->connections.begin(), universe->connections.end(), pred);
-  universe->connections.erase(pos, universe->connections.end());
+  if (c && c->author == this) {
+    universe->connections.erase(from, to);
+  }
 }
 
 Connection* Infrastructure::connection(Endpoint* from, Endpoint* to) {
-  for (Connection& c : universe->connections) {
-    if (c.from == from && c.to == to) {
-      return &c;
-    }
-  }
-  return nullptr;
+  return universe->connections.find(from, to);
 }
@@ -9,6 +9,9 @@
 
 class Component;
 class Universe;
+struct TextMailbox;
+struct DataMailbox;
+struct VideoBuffer;
 
 class Endpoint {
 public:
@@ -25,6 +28,12 @@ public:
   Component* component = nullptr;
   Capabilities capabilities;
   glm::vec2 position;
+
+  /* Message rings, set by TextSystem and DataSystem while the port carries text or data */
+  TextMailbox* textMailbox = nullptr;
+  DataMailbox* dataMailbox = nullptr;
+  /* Frame triple buffer, set by VideoSystem while the port carries video */
+  VideoBuffer* videoBuffer = nullptr;
 };
 
 class Infrastructure;
@@ -41,6 +50,8 @@ struct Connection {
   Endpoint* to;
   Capabilities capabilities;
   Infrastructure* author;
+  /* Assigned by ConnectionGraph in creation order, keys per-edge random streams */
+  uint64_t id = 0;
 };
 
 class Infrastructure {
@@ -52,6 +63,7 @@ public:
   virtual ~Infrastructure() = default;
 
   virtual void update() = 0;
+  virtual void render() { }
 
   void connect(Endpoint* from, Endpoint* to, Capabilities capabilities);
   void disconnect(Endpoint* from, Endpoint* to);
@@ -11,6 +11,9 @@
 #include <Foundation/Universe.hpp>
 
 void Manual::update() {
+}
+
+void Manual::render() {
   ImGui::SetNextWindowPos({ 0.0f, ImGui::GetIO().DisplaySize.y - 36.0f });
   ImGui::SetNextWindowSize({ ImGui::GetIO().DisplaySize.x, 32.0f });
   ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4 { 0.0f, 0.0f, 0.0f, 0.0f });
@@ -96,6 +99,10 @@ void Manual::load(const fs::path& path) {
   json connections;
   inf >> connections;
 
+  this->load(connections);
+}
+
+void Manual::load(const json& connections) {
   for (auto& connection : connections) {
     Endpoint* a = this->universe->lookupPort(connection["a"]["component"], connection["a"]["port"]);
     Endpoint* b = this->universe->lookupPort(connection["b"]["component"], connection["b"]["port"]);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <json.hpp>
+
 #include <Foundation/Infrastructures/Infrastructure.hpp>
 #include <Util/Filesystem.hpp>
 
@@ -8,9 +10,11 @@ public:
   using Infrastructure::Infrastructure;
 
   void update() override;
+  void render() override;
 
   void save(const fs::path& path);
   void load(const fs::path& path);
+  void load(const json& connections);
 
 private:
   char buf[256] {};
@@ -0,0 +1,228 @@
+#include <Foundation/Infrastructures/Ropes.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+  constexpr float gravity = 400.0f;
+  constexpr float damping = 0.98f;
+  /* Ropes fall asleep after this many steps moving less than stillDistance */
+  constexpr uint32_t sleepAfter = 30;
+  constexpr float stillDistance = 0.01f;
+}
+
+uint32_t RopeSimulation::add(glm::vec2 a, glm::vec2 b, float length) {
+  uint32_t rope = this->count++;
+
+  if (rope % lanes == 0) {
+    for (auto* v : { &this->x, &this->y, &this->px, &this->py }) {
+      v->resize(v->size() + lanes * points, 0.0f);
+    }
+    for (auto* v : { &this->active, &this->rest, &this->ax, &this->ay, &this->bx, &this->by }) {
+      v->resize(v->size() + lanes, 0.0f);
+    }
+  }
+
+  for (uint32_t i = 0; i < points; i++) {
+    glm::vec2 p = a + (b - a) * (float(i) / float(points - 1));
+    size_t ix = index(rope, i);
+    this->x[ix] = this->px[ix] = p.x;
+    this->y[ix] = this->py[ix] = p.y;
+  }
+
+  this->active[rope] = 1.0f;
+  this->rest[rope] = length / float(points - 1);
+  this->pin(rope, a, b);
+  this->wake();
+
+  return rope;
+}
+
+void RopeSimulation::pin(uint32_t rope, glm::vec2 a, glm::vec2 b) {
+  if (this->ax[rope] == a.x && this->ay[rope] == a.y && this->bx[rope] == b.x && this->by[rope] == b.y) {
+    return;
+  }
+
+  this->ax[rope] = a.x;
+  this->ay[rope] = a.y;
+  this->bx[rope] = b.x;
+  this->by[rope] = b.y;
+  this->wake();
+}
+
+void RopeSimulation::resize(uint32_t rope, float length) {
+  float rest = length / float(points - 1);
+  if (this->rest[rope] == rest) {
+    return;
+  }
+
+  this->rest[rope] = rest;
+  this->wake();
+}
+
+void RopeSimulation::step(float dt, const std::vector<Obstacle>& obstacles) {
+  if (this->idle || this->count == 0) {
+    return;
+  }
+
+  float motion = this->integrate(dt);
+  this->attach();
+
+  for (uint32_t it = 0; it < iterations; it++) {
+    this->constrain();
+  }
+  /* Collisions go last so no point is left inside an obstacle */
+  if (!obstacles.empty()) {
+    this->collide(obstacles);
+  }
+
+  if (motion < stillDistance * stillDistance) {
+    this->idle = ++this->stillSteps >= sleepAfter;
+  }
+  else {
+    this->stillSteps = 0;
+  }
+}
+
+float RopeSimulation::integrate(float dt) {
+  const float fall = gravity * dt * dt;
+  size_t blocks = this->active.size() / lanes;
+
+  /* Per-lane maxima keep the inner loop free of cross-lane reductions */
+  float motion[lanes] = {};
+
+  for (size_t blk = 0; blk < blocks; blk++) {
+    const float* __restrict on = &this->active[blk * lanes];
+
+    for (uint32_t i = 1; i + 1 < points; i++) {
+      size_t base = (blk * points + i) * lanes;
+      float* __restrict X = &this->x[base];
+      float* __restrict Y = &this->y[base];
+      float* __restrict PX = &this->px[base];
+      float* __restrict PY = &this->py[base];
+
+      for (uint32_t l = 0; l < lanes; l++) {
+        float vx = (X[l] - PX[l]) * damping * on[l];
+        float vy = (Y[l] - PY[l]) * damping * on[l];
+        motion[l] = std::max(motion[l], vx * vx + vy * vy);
+        PX[l] = X[l];
+        PY[l] = Y[l];
+        X[l] += vx;
+        Y[l] += vy + fall * on[l];
+      }
+    }
+  }
+
+  return *std::max_element(motion, motion + lanes);
+}
+
+void RopeSimulation::constrain() {
+  size_t blocks = this->active.size() / lanes;
+
+  for (size_t blk = 0; blk < blocks; blk++) {
+    const float* __restrict R = &this->rest[blk * lanes];
+
+    for (uint32_t i = 0; i + 1 < points; i++) {
+      /* Pinned ends don't move, the free point takes the whole correction */
+      float c0 = i == 0 ? 0.0f : (i + 2 == points ? 2.0f : 1.0f);
+      float c1 = i + 2 == points ? 0.0f : (i == 0 ? 2.0f : 1.0f);
+
+      size_t base = (blk * points + i) * lanes;
+      float* __restrict X0 = &this->x[base];
+      float* __restrict Y0 = &this->y[base];
+      float* __restrict X1 = &this->x[base + lanes];
+      float* __restrict Y1 = &this->y[base + lanes];
+
+      /*
+       * Square-root-free length constraint (Jakobsen, "Advanced Character
+       * Physics"), exact at rest length and converging over iterations.
+       */
+      for (uint32_t l = 0; l < lanes; l++) {
+        float dx = X1[l] - X0[l];
+        float dy = Y1[l] - Y0[l];
+        float r2 = R[l] * R[l];
+        /* Guarded for padding lanes, which have zero rest length and all points at the origin */
+        float k = r2 / std::max(dx * dx + dy * dy + r2, 1e-12f) - 0.5f;
+        dx *= k;
+        dy *= k;
+        X0[l] -= dx * c0;
+        Y0[l] -= dy * c0;
+        X1[l] += dx * c1;
+        Y1[l] += dy * c1;
+      }
+    }
+  }
+}
+
+void RopeSimulation::collide(const std::vector<Obstacle>& obstacles) {
+  size_t blocks = this->active.size() / lanes;
+
+  for (size_t blk = 0; blk < blocks; blk++) {
+    const float* on = &this->active[blk * lanes];
+    size_t first = blk * points * lanes;
+
+    /* Bounds of the block's ropes, padding lanes sit at the origin and are left out */
+    float minX = std::numeric_limits<float>::infinity();
+    float minY = std::numeric_limits<float>::infinity();
+    float maxX = -std::numeric_limits<float>::infinity();
+    float maxY = -std::numeric_limits<float>::infinity();
+    for (uint32_t i = 0; i < points; i++) {
+      for (uint32_t l = 0; l < lanes; l++) {
+        if (on[l] != 0.0f) {
+          size_t ix = first + i * lanes + l;
+          minX = std::min(minX, this->x[ix]);
+          maxX = std::max(maxX, this->x[ix]);
+          minY = std::min(minY, this->y[ix]);
+          maxY = std::max(maxY, this->y[ix]);
+        }
+      }
+    }
+
+    for (const Obstacle& o : obstacles) {
+      if (o.center.x + o.radius < minX || o.center.x - o.radius > maxX ||
+          o.center.y + o.radius < minY || o.center.y - o.radius > maxY) {
+        continue;
+      }
+
+      const float r2 = o.radius * o.radius;
+
+      /* Pinned ends are skipped */
+      for (uint32_t i = 1; i + 1 < points; i++) {
+        for (uint32_t l = 0; l < lanes; l++) {
+          if (on[l] == 0.0f) {
+            continue;
+          }
+
+          size_t ix = first + i * lanes + l;
+          float dx = this->x[ix] - o.center.x;
+          float dy = this->y[ix] - o.center.y;
+          float d2 = dx * dx + dy * dy;
+
+          if (d2 < r2 && d2 > 1e-6f) {
+            float s = o.radius / std::sqrt(d2);
+            this->x[ix] = o.center.x + dx * s;
+            this->y[ix] = o.center.y + dy * s;
+          }
+        }
+      }
+    }
+  }
+}
+
+void RopeSimulation::attach() {
+  size_t blocks = this->active.size() / lanes;
+
+  for (size_t blk = 0; blk < blocks; blk++) {
+    size_t first = blk * points * lanes;
+    size_t last = first + (points - 1) * lanes;
+
+    for (uint32_t l = 0; l < lanes; l++) {
+      size_t r = blk * lanes + l;
+      this->x[first + l] = this->px[first + l] = this->ax[r];
+      this->y[first + l] = this->py[first + l] = this->ay[r];
+      this->x[last + l] = this->px[last + l] = this->bx[r];
+      this->y[last + l] = this->py[last + l] = this->by[r];
+    }
+  }
+}
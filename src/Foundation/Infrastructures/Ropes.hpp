@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/*
+ * Verlet ropes with pinned ends, used to draw cables. Points are stored as
+ * structure-of-arrays in blocks of `lanes` ropes: for each block and each
+ * point index the coordinates of all ropes in the block are contiguous, so
+ * integration and length constraints run as straight vector loops across
+ * ropes. Blocks are only ever appended, adding a rope never moves others.
+ *
+ * Ropes fall asleep once nothing moves and wake up when a pin changes.
+ */
+class RopeSimulation {
+public:
+  static constexpr uint32_t lanes = 8;
+  static constexpr uint32_t points = 16;
+  static constexpr uint32_t iterations = 8;
+
+  struct Obstacle {
+    glm::vec2 center;
+    float radius;
+  };
+
+  /* Returns the index of a new rope of the given length, laid straight from a to b */
+  uint32_t add(glm::vec2 a, glm::vec2 b, float length);
+
+  /* Moves the ends of a rope, wakes the simulation if they changed */
+  void pin(uint32_t rope, glm::vec2 a, glm::vec2 b);
+
+  /* Changes the length of a rope, wakes the simulation if it changed */
+  void resize(uint32_t rope, float length);
+
+  /* Advances every rope by dt, points are pushed out of the obstacles. Does nothing while asleep */
+  void step(float dt, const std::vector<Obstacle>& obstacles);
+
+  void wake() {
+    this->idle = false;
+    this->stillSteps = 0;
+  }
+
+  glm::vec2 point(uint32_t rope, uint32_t i) const {
+    size_t ix = index(rope, i);
+    return { this->x[ix], this->y[ix] };
+  }
+
+  uint32_t size() const {
+    return this->count;
+  }
+
+  bool asleep() const {
+    return this->idle;
+  }
+
+private:
+  static size_t index(uint32_t rope, uint32_t i) {
+    return (size_t(rope / lanes) * points + i) * lanes + rope % lanes;
+  }
+
+  /* Returns the largest squared displacement of any point over the previous step */
+  float integrate(float dt);
+  void constrain();
+  void collide(const std::vector<Obstacle>& obstacles);
+  void attach();
+
+  uint32_t count = 0;
+  bool idle = false;
+  uint32_t stillSteps = 0;
+
+  /* Current and previous positions, lanes * points floats per block */
+  std::vector<float> x, y;
+  std::vector<float> px, py;
+
+  /* Per-rope data, one float per lane. Unused lanes of the last block are inactive and never move */
+  std::vector<float> active;
+  std::vector<float> rest;
+  std::vector<float> ax, ay;
+  std::vector<float> bx, by;
+};
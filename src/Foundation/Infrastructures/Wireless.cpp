@@ -1,40 +1,86 @@
 #include <Foundation/Infrastructures/Wireless.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 #include <Foundation/Universe.hpp>
 
+void Antenna::tune(float f) {
+  if (f == this->frequency) {
+    return;
+  }
+
+  this->frequency = f;
+  if (this->component != nullptr) {
+    this->component->universe->connections.moved(this);
+  }
+}
+
+Wireless::Wireless(Universe* u)
+  : Infrastructure { u }
+{ }
+
+Wireless::~Wireless() {
+  this->universe->connections.unsubscribe(this);
+}
+
 void Wireless::update() {
-  for (auto& componentA : this->universe->components) {
-    for (auto& componentB : this->universe->components) {
-      if (componentA == componentB) {
+  for (Antenna* a : this->dirty) {
+    for (Antenna* b : this->antennas) {
+      if (a->component == b->component) {
         continue;
       }
 
-      for (auto& aPair : componentA->ports) {
-        for (auto& bPair : componentB->ports) {
-          auto* a = dynamic_cast<Antenna*>(aPair.second.get());
-          auto* b = dynamic_cast<Antenna*>(bPair.second.get());
-
-          if (!a || !b) {
-            continue;
-          }
-
-          float distance = glm::distance(a->globalPosition(), b->globalPosition());
-          if (distance <= a->radius) {
-            Capabilities caps {
-                .video = { true, std::fabs(a->frequency - b->frequency) },
-                .energy = { false, 0.0f },
-                .text = { false },
-            };
-
-            connect(a, b, caps);
-          }
-          else if (auto conn = connection(a, b)) {
-            if (conn->author == this) {
-              disconnect(a, b);
-            }
-          }
-        }
-      }
+      this->relink(a, b);
+      this->relink(b, a);
+    }
+  }
+
+  this->dirty.clear();
+  this->pending.clear();
+}
+
+void Wireless::moved(Endpoint& endpoint) {
+  auto* a = dynamic_cast<Antenna*>(&endpoint);
+  if (!a) {
+    return;
+  }
+
+  if (this->known.insert(a).second) {
+    this->antennas.push_back(a);
+  }
+  if (this->pending.insert(a).second) {
+    this->dirty.push_back(a);
+  }
+}
+
+void Wireless::removed(Endpoint& endpoint) {
+  auto* a = dynamic_cast<Antenna*>(&endpoint);
+  if (!a || this->known.erase(a) == 0) {
+    return;
+  }
+
+  this->antennas.erase(std::find(this->antennas.begin(), this->antennas.end(), a));
+  if (this->pending.erase(a) != 0) {
+    this->dirty.erase(std::find(this->dirty.begin(), this->dirty.end(), a));
+  }
+}
+
+void Wireless::relink(Antenna* a, Antenna* b) {
+  float distance = glm::distance(a->globalPosition(), b->globalPosition());
+  if (distance <= a->radius) {
+    Capabilities caps {
+        .video = { true, std::fabs(a->frequency - b->frequency) },
+        .energy = { false, 0.0f },
+        .text = { false },
+        .data = { false },
+    };
+
+    connect(a, b, caps);
+  }
+  else if (auto conn = connection(a, b)) {
+    if (conn->author == this) {
+      disconnect(a, b);
     }
   }
 }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <unordered_set>
+#include <vector>
+
 #include <Foundation/Infrastructures/Infrastructure.hpp>
+#include <Foundation/Infrastructures/ConnectionGraph.hpp>
 
 class Antenna : public Endpoint {
 public:
@@ -10,15 +14,35 @@ public:
     , frequency { f }
   { }
 
+  /* Changes frequency and republishes the antenna so its links are recomputed */
+  void tune(float f);
+
   float radius;
   float frequency;
 };
 
-class Wireless : public Infrastructure {
+/*
+ * Links antennas in range of each other. Only antennas published as moved
+ * since the last update are re-linked, a frame without edits does nothing.
+ */
+class Wireless : public Infrastructure, public ConnectionListener {
 public:
-  using Infrastructure::Infrastructure;
+  explicit Wireless(Universe* u);
+  ~Wireless() override;
 
   void update() override;
-};
 
+  void moved(Endpoint& endpoint) override;
+  void removed(Endpoint& endpoint) override;
 
+private:
+  /* Connects or disconnects a -> b depending on a's range */
+  void relink(Antenna* a, Antenna* b);
+
+  std::vector<Antenna*> antennas;
+  std::unordered_set<Antenna*> known;
+
+  /* Antennas to re-link, in the order they were published */
+  std::vector<Antenna*> dirty;
+  std::unordered_set<Antenna*> pending;
+};
@@ -9,106 +9,223 @@
 #include <Foundation/Universe.hpp>
 #include <Foundation/Components/Component.hpp>
 
+Wiring::Wiring(Universe* u)
+  : Infrastructure { u }
+  , nearby { snapDistance }
+{ }
+
 Wiring::~Wiring() {
-  for (auto* cable : this->cables) {
-    delete cable;
-  }
+  this->universe->connections.unsubscribe(this);
 }
 
 EndpointConnector* Wiring::findOther(EndpointConnector* connector) {
-  Connector* prev = connector;
-  Connector* next = nullptr;
+  if (this->chainsDirty) {
+    this->rebuildChains();
+  }
 
-  for (const WiringConnection& connection : this->connections) {
-    if (connection.a == connector) {
-      next = connection.b;
-    }
-    else if (connection.b == connector) {
-      next = connection.a;
-    }
+  auto& ends = this->chainEnds[this->chains.find(connector->id)];
+  if (ends[0] == connector) {
+    return ends[1];
+  }
+  if (ends[1] == connector) {
+    return ends[0];
   }
+  return nullptr;
+}
 
-  bool stepMade = false;
-  do {
-    stepMade = false;
-    for (auto& connection : connections) {
-      if (connection.a == next || connection.b == next) {
-        if (connection.a == prev || connection.b == prev) {
-          continue;
-        }
-        else if (connection.a == next) {
-          prev = next;
-          next = connection.b;
-          stepMade = true;
-        }
-        else if (connection.b == next) {
-          prev = next;
-          next = connection.a;
-          stepMade = true;
-        }
-      }
+void Wiring::registerConnector(Connector* c) {
+  c->id = this->chains.add();
+  c->wiring = this;
+  this->chainEnds.push_back({ dynamic_cast<EndpointConnector*>(c), nullptr });
+  this->connectors.push_back(c);
+  this->movedConnectors.push_back(c->id);
+}
+
+void Wiring::unregisterConnector(Connector* c) {
+  if (c->other != nullptr) {
+    this->separate(c, c->other);
+  }
+
+  this->setMagnetic(c, false);
+  this->connectors[c->id] = nullptr;
+  this->nearby.remove(c);
+  this->chainsDirty = true;
+  this->topologyDirty = true;
+}
+
+PositionHandle Wiring::acquirePosition(glm::vec2 value) {
+  return this->positions.emplace(ConnectorPosition { value });
+}
+
+PositionHandle Wiring::sharePosition(PositionHandle handle) {
+  this->positions[handle].references++;
+  return handle;
+}
+
+void Wiring::releasePosition(PositionHandle handle) {
+  if (--this->positions[handle].references == 0) {
+    this->positions.erase(handle);
+  }
+}
+
+void Wiring::uniteChains(Connector* a, Connector* b) {
+  uint32_t ra = this->chains.find(a->id);
+  uint32_t rb = this->chains.find(b->id);
+  if (ra == rb) {
+    return;
+  }
+
+  /* Each connector has at most one external and one internal link, so a chain has two ends */
+  std::array<EndpointConnector*, 2> ends { nullptr, nullptr };
+  size_t n = 0;
+  for (EndpointConnector* e : { this->chainEnds[ra][0], this->chainEnds[ra][1], this->chainEnds[rb][0], this->chainEnds[rb][1] }) {
+    if (e != nullptr && n < ends.size()) {
+      ends[n++] = e;
     }
-  } while (stepMade);
+  }
 
-  return dynamic_cast<EndpointConnector*>(next);
+  this->chainEnds[this->chains.unite(ra, rb)] = ends;
+}
+
+void Wiring::rebuildChains() {
+  this->chains.reset(this->chainEnds.size());
+  for (size_t id = 0; id < this->connectors.size(); id++) {
+    this->chainEnds[id] = { dynamic_cast<EndpointConnector*>(this->connectors[id]), nullptr };
+  }
+
+  for (const WiringConnection& connection : this->connections) {
+    this->uniteChains(connection.a, connection.b);
+  }
+
+  this->chainsDirty = false;
 }
 
 void Wiring::update() {
-  /* Update connections */
-  for (auto* connector : this->connectors) {
-    if (auto* from = dynamic_cast<EndpointConnector*>(connector)) {
-      if (auto* to = this->findOther(from)) {
-        this->connect(from->endpoint, to->endpoint, Capabilities{});
+  /* Endpoint connections only change when some chain was joined or separated */
+  if (this->topologyDirty) {
+    this->topologyDirty = false;
+
+    /* Update connections */
+    for (auto* connector : this->connectors) {
+      if (auto* from = dynamic_cast<EndpointConnector*>(connector)) {
+        if (auto* to = this->findOther(from)) {
+          this->connect(from->endpoint, to->endpoint, Capabilities{});
+        }
       }
     }
-  }
 
-  /* Disconnect broken connections */
-  for (auto& connection : this->universe->connections) {
-    if (connection.author == this) {
-      auto* as = dynamic_cast<Socket*>(connection.from);
-      auto* bs = dynamic_cast<Socket*>(connection.to);
+    /* Disconnect broken connections */
+    std::vector<std::pair<Socket*, Socket*>> broken;
+    for (auto& connection : this->universe->connections) {
+      if (connection.author == this) {
+        auto* as = dynamic_cast<Socket*>(connection.from);
+        auto* bs = dynamic_cast<Socket*>(connection.to);
 
-      if (as && bs && (findOther(&as->connector) != &bs->connector || findOther(&bs->connector) != &as->connector)) {
-        disconnect(as, bs);
+        if (as && bs && (findOther(&as->connector) != &bs->connector || findOther(&bs->connector) != &as->connector)) {
+          broken.emplace_back(as, bs);
+        }
       }
     }
+    for (auto& pair : broken) {
+      disconnect(pair.first, pair.second);
+    }
+  }
+
+  /* Refresh positions of connectors that moved */
+  if (!this->movedConnectors.empty() || !this->magnets.empty()) {
+    this->ropesDirty = true;
+  }
+  for (uint32_t id : this->movedConnectors) {
+    if (Connector* c = this->connectors[id]) {
+      this->nearby.update(c, c->position());
+    }
   }
+  this->movedConnectors.clear();
+
+  /* Connect close connectors, only pairs with a magnetic connector snap so only their neighbourhoods are searched */
+  for (Connector* a : this->magnets) {
+    glm::vec2 aPos = a->position();
+    this->nearby.update(a, aPos);
 
-  /* Connect close connectors */
-  for (Connector* a : this->connectors) {
-    for (Connector* b : this->connectors) {
+    this->nearby.query(aPos, [&](Connector* b) {
       if (a == b) {
-        continue;
+        return;
       }
 
-      auto eitherMagnetic = a->magnetic || b->magnetic;
       auto bothFree = !this->occupied(a) && !this->occupied(b);
-      auto bothClose = glm::distance(a->position(), b->position()) < 6.0f;
+      auto bothClose = glm::distance(aPos, b->position()) < snapDistance;
 
-      if (eitherMagnetic && bothFree && bothClose) {
+      if (bothFree && bothClose) {
         this->join(a, b);
       }
+    });
+  }
+}
+
+void Wiring::moved(Endpoint& endpoint) {
+  this->ropesDirty = true;
+  if (auto* s = dynamic_cast<Socket*>(&endpoint)) {
+    this->movedConnectors.push_back(s->connector.id);
+  }
+}
+
+void Wiring::setMagnetic(Connector* c, bool magnetic) {
+  if (c->magnetic == magnetic) {
+    return;
+  }
+
+  c->magnetic = magnetic;
+  if (magnetic) {
+    this->magnets.push_back(c);
+  }
+  else {
+    this->magnets.erase(std::find(this->magnets.begin(), this->magnets.end(), c));
+    this->movedConnectors.push_back(c->id);
+    /* A dragged end was put down */
+    this->fitRope(c);
+  }
+}
+
+void Wiring::fitRope(Connector* c) {
+  auto* end = dynamic_cast<CableConnector*>(c);
+  if (end == nullptr || end->cable == nullptr) {
+    return;
+  }
+
+  Cable& cable = *end->cable;
+  float distance = glm::distance(cable.a.position(), cable.b.position());
+  this->ropes.resize(cable.rope, std::max(distance * slack, minRopeLength));
+  this->ropesDirty = true;
+}
+
+void Wiring::render() {
+  /* Ropes are only drawn, so they step with the frame rate and stay out of headless runs */
+  if (this->ropesDirty) {
+    this->ropesDirty = false;
+
+    this->obstacles.clear();
+    for (auto& c : this->universe->components) {
+      this->obstacles.push_back({ c->position, handleRadius });
     }
+
+    this->cables.forEach([&](Cable& cable) {
+      this->ropes.pin(cable.rope, cable.a.position(), cable.b.position());
+    });
+    /* Obstacles may have moved even if no pin did */
+    this->ropes.wake();
   }
+  /* Long frames are clamped, a Verlet step that large would overshoot */
+  this->ropes.step(std::min(ImGui::GetIO().DeltaTime, maxRopeStep), this->obstacles);
 
   ImGui::Begin("Switchboard");
 
   if (ImGui::Button("Add Cable")) {
-    cables.emplace_back(this->createCable(glm::vec2 { 0.0f, 0.0f }, glm::vec2 { 50.0f, 0.0f }));
+    this->createCable(glm::vec2 { 0.0f, 0.0f }, glm::vec2 { 50.0f, 0.0f });
   }
 
   ImGui::End();
 }
 
-bool Wiring::occupied(Connector* c) const {
-  auto pred = [&](const WiringConnection& conn) {
-    return (conn.a == c || conn.b == c) && !conn.internal;
-  };
-
-  return std::find_if(this->connections.begin(), this->connections.end(), pred) != this->connections.end();
-}
-
 void Wiring::join(Connector* a, Connector* b, bool internal) {
   WiringConnection connection { a, b, internal };
 
@@ -117,9 +234,19 @@ void Wiring::join(Connector* a, Connector* b, bool internal) {
   }
 
   this->connections.emplace(connection);
+  if (!this->chainsDirty) {
+    this->uniteChains(a, b);
+  }
+  this->topologyDirty = true;
+  this->movedConnectors.push_back(a->id);
+  this->movedConnectors.push_back(b->id);
 
   if (!internal) {
+    a->externalConnections++;
+    b->externalConnections++;
     a->merge(b);
+    this->fitRope(a);
+    this->fitRope(b);
   }
 }
 
@@ -131,42 +258,63 @@ void Wiring::separate(Connector* a, Connector* b, bool internal) {
   }
 
   this->connections.erase(connection);
+  /* Union-find can't split, the chains are rebuilt on the next lookup */
+  this->chainsDirty = true;
+  this->topologyDirty = true;
+  this->movedConnectors.push_back(a->id);
+  this->movedConnectors.push_back(b->id);
 
   if (!internal) {
+    a->externalConnections--;
+    b->externalConnections--;
     a->split(b);
   }
 }
 
 Socket* Wiring::createSocket(Capabilities c) {
   auto* ptr = new Socket { c };
-  this->connectors.emplace(&ptr->connector);
+  this->registerConnector(&ptr->connector);
+  /* The socket isn't attached to a component yet, its position is filled in on first use */
+  ptr->connector.positionHandle = this->acquirePosition(glm::vec2 { 0.0f, 0.0f });
   return ptr;
 }
 
-Cable* Wiring::createCable(glm::vec2 aPos, glm::vec2 bPos) {
-  auto* ptr = new Cable { aPos, bPos };
-  this->join(&ptr->a, &ptr->b, true);
-  this->connectors.emplace(&ptr->a);
-  this->connectors.emplace(&ptr->b);
-  return ptr;
+CableHandle Wiring::createCable(glm::vec2 aPos, glm::vec2 bPos) {
+  CableHandle handle = this->cables.emplace(this, aPos, bPos);
+  Cable& cable = this->cables[handle];
+  cable.a.cable = &cable;
+  cable.b.cable = &cable;
+  cable.rope = this->ropes.add(aPos, bPos, std::max(glm::distance(aPos, bPos) * slack, minRopeLength));
+  this->registerConnector(&cable.a);
+  this->registerConnector(&cable.b);
+  this->join(&cable.a, &cable.b, true);
+  return handle;
+}
+
+CableConnector::CableConnector(Wiring* w, glm::vec2 pos) {
+  this->wiring = w;
+  this->positionHandle = w->acquirePosition(pos);
+}
+
+CableConnector::~CableConnector() {
+  this->wiring->releasePosition(this->positionHandle);
+}
+
+glm::vec2& CableConnector::position() {
+  return this->wiring->positions[this->positionHandle].value;
 }
 
 void CableConnector::merge(Connector* other) {
+  /* Merged connectors alias a single position slot */
   if (auto* c = dynamic_cast<CableConnector*>(other)) {
-    auto* newPosition = new glm::vec2 { 0.5f * (*this->cablePosition + *c->cablePosition) };
+    this->position() = 0.5f * (this->position() + c->position());
 
-    delete this->cablePosition;
-    this->cablePosition = newPosition;
-    this->owner = true;
-
-    delete c->cablePosition;
-    c->cablePosition = newPosition;
-    c->owner = false;
+    this->wiring->releasePosition(c->positionHandle);
+    c->positionHandle = this->wiring->sharePosition(this->positionHandle);
   }
   else if (auto* e = dynamic_cast<EndpointConnector*>(other)) {
-    delete this->cablePosition;
-    this->cablePosition = &e->position();
-    this->owner = false;
+    this->wiring->releasePosition(this->positionHandle);
+    this->positionHandle = this->wiring->sharePosition(e->positionHandle);
   }
 
   this->other = other;
@@ -176,25 +324,36 @@ void CableConnector::merge(Connector* other) {
 void CableConnector::split(Connector* other) {
   const glm::vec2 offset { 10.0f, 10.0f };
 
-  if (auto* c = dynamic_cast<CableConnector*>(other)) {
-    glm::vec2 oldPos = this->position();
-
-    delete this->cablePosition;
+  /* The endpoint isn't asked for its position, it may be in the middle of being destroyed */
+  glm::vec2 oldPos = this->wiring->positions[this->positionHandle].value;
 
-    this->cablePosition = new glm::vec2 { oldPos + offset };
-    this->owner = true;
-    c->cablePosition = new glm::vec2 { oldPos - offset };
-    c->owner = true;
+  if (auto* c = dynamic_cast<CableConnector*>(other)) {
+    this->wiring->releasePosition(c->positionHandle);
+    c->positionHandle = this->wiring->acquirePosition(oldPos - offset);
+    this->position() = oldPos + offset;
   }
-  else if (auto* e = dynamic_cast<EndpointConnector*>(other)) {
-    this->cablePosition = new glm::vec2 { e->position() + offset };
-    this->owner = true;
+  else if (dynamic_cast<EndpointConnector*>(other)) {
+    this->wiring->releasePosition(this->positionHandle);
+    this->positionHandle = this->wiring->acquirePosition(oldPos + offset);
   }
 
   this->other = nullptr;
   other->other = nullptr;
 }
 
+EndpointConnector::~EndpointConnector() {
+  if (this->wiring != nullptr) {
+    this->wiring->unregisterConnector(this);
+    this->wiring->releasePosition(this->positionHandle);
+  }
+}
+
+glm::vec2& EndpointConnector::position() {
+  glm::vec2& p = this->wiring->positions[this->positionHandle].value;
+  p = this->endpoint->globalPosition();
+  return p;
+}
+
 void EndpointConnector::merge(Connector* other) {
   if (auto* c = dynamic_cast<CableConnector*>(other)) {
     c->merge(this);
@@ -217,9 +376,9 @@ EndpointConnector::EndpointConnector(Endpoint* e)
   : endpoint { e }
 { }
 
-Cable::Cable(glm::vec2 aPos, glm::vec2 bPos)
-  : a { aPos }
-  , b { bPos }
+Cable::Cable(Wiring* w, glm::vec2 aPos, glm::vec2 bPos)
+  : a { w, aPos }
+  , b { w, bPos }
 { }
 
 WiringConnection::WiringConnection(Connector* a, Connector* b, bool internal)
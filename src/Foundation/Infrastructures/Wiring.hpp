@@ -1,12 +1,29 @@
 #pragma once
 
+#include <array>
 #include <set>
+#include <vector>
 
 #include <Foundation/Infrastructures/Infrastructure.hpp>
+#include <Foundation/Infrastructures/ConnectionGraph.hpp>
+#include <Foundation/Infrastructures/Ropes.hpp>
+#include <Util/DisjointSets.hpp>
+#include <Util/Pool.hpp>
+#include <Util/SpatialHash.hpp>
 
 class Wiring;
+class Cable;
+
+/* Connector position, shared by both connectors while they're merged */
+struct ConnectorPosition {
+  glm::vec2 value;
+  uint32_t references = 1;
+};
+
+using PositionHandle = Handle<ConnectorPosition>;
 
 class Connector {
+  friend class Wiring;
 public:
   virtual ~Connector() = default;
 
@@ -16,60 +33,64 @@ public:
 
   bool magnetic = false;
   Connector* other = nullptr;
+  /* Non-internal connections, maintained by Wiring::join and Wiring::separate */
+  uint32_t externalConnections = 0;
+  /* Index into Wiring's connector tables, assigned on registration */
+  uint32_t id = 0;
+
+protected:
+  Wiring* wiring = nullptr;
+  PositionHandle positionHandle;
 };
 
 class CableConnector : public Connector {
+  friend class Wiring;
 public:
-  CableConnector(glm::vec2 pos)
-    : cablePosition { new glm::vec2 { pos } }
-  { }
-
-  virtual ~CableConnector() {
-    if (this->owner) {
-      delete this->cablePosition;
-    }
-  }
+  CableConnector(Wiring* w, glm::vec2 pos);
+  ~CableConnector() override;
 
   void merge(Connector* other) override;
   void split(Connector* other) override;
 
-  glm::vec2& position() override {
-    return *cablePosition;
-  }
+  glm::vec2& position() override;
 
 private:
-  glm::vec2* cablePosition;
-  bool owner = false;
+  /* Cable this is an end of, set by Wiring::createCable */
+  Cable* cable = nullptr;
 };
 
 class EndpointConnector : public Connector {
   friend class Wiring;
+  friend class CableConnector;
 public:
   explicit EndpointConnector(Endpoint* e);
+  ~EndpointConnector() override;
 
   void merge(Connector* other) override;
   void split(Connector* other) override;
 
-  glm::vec2& position() override {
-    fakePosition = endpoint->globalPosition();
-    return fakePosition;
-  }
+  /* Refreshed from the endpoint whenever it's asked for */
+  glm::vec2& position() override;
 
 private:
   Endpoint* endpoint;
-  glm::vec2 fakePosition;
 };
 
 class Cable {
   friend class Wiring;
+  friend class Pool<Cable>;
 public:
   CableConnector a;
   CableConnector b;
+  /* Index into Wiring's rope simulation, the ends follow a and b */
+  uint32_t rope = 0;
 
 private:
-  Cable(glm::vec2 aPos, glm::vec2 bPos);
+  Cable(Wiring* w, glm::vec2 aPos, glm::vec2 bPos);
 };
 
+using CableHandle = Handle<Cable>;
+
 class Socket : public Endpoint {
   friend class Wiring;
 public:
@@ -103,26 +124,92 @@ static bool operator<(const WiringConnection& a, const WiringConnection& b) {
   }
 }
 
-class Wiring : public Infrastructure {
+/*
+ * Cables and sockets. Endpoint connections are only re-derived after a
+ * join or separation, and snapping only looks at connectors that moved or
+ * are being dragged, so a frame without edits does no work.
+ */
+class Wiring : public Infrastructure, public ConnectionListener {
   friend void DrawGraph(Universe& universe);
+  friend class CableConnector;
+  friend class EndpointConnector;
 public:
-  using Infrastructure::Infrastructure;
+  /* Free connectors closer than this snap together if either is magnetic */
+  static constexpr float snapDistance = 6.0f;
+  /* Ropes are this much longer than the distance between their ends, refitted whenever an end is put down */
+  static constexpr float slack = 1.2f;
+  static constexpr float minRopeLength = 20.0f;
+  /* Rope points are kept out of component handles by this radius */
+  static constexpr float handleRadius = 8.0f;
+  /* Longest time step the ropes take in one frame, in seconds */
+  static constexpr float maxRopeStep = 1.0f / 30.0f;
+
+  explicit Wiring(Universe* u);
   ~Wiring() final;
 
   void update() override;
+  void render() override;
+
+  void moved(Endpoint& endpoint) override;
 
-  bool occupied(Connector* c) const;
+  /* Magnetic connectors snap to free connectors nearby, set while one is dragged */
+  void setMagnetic(Connector* c, bool magnetic);
+
+  bool occupied(const Connector* c) const {
+    return c->externalConnections != 0;
+  }
 
   Socket* createSocket(Capabilities c);
-  Cable* createCable(glm::vec2 aPos, glm::vec2 bPos);
+  CableHandle createCable(glm::vec2 aPos, glm::vec2 bPos);
 
 private:
   std::set<WiringConnection> connections;
-  std::vector<Cable*> cables;
-  std::set<Connector*> connectors;
+
+  /* Positions are declared first, cable connectors release theirs on destruction */
+  Pool<ConnectorPosition> positions;
+  Pool<Cable> cables;
+
+  /* Registered connectors indexed by id, null once unregistered */
+  std::vector<Connector*> connectors;
+
+  /* Connector positions bucketed by snapDistance, refreshed when they move */
+  SpatialHash<Connector*> nearby;
+  /* Ids of connectors whose position changed since the last update */
+  std::vector<uint32_t> movedConnectors;
+  std::vector<Connector*> magnets;
+
+  /* Set by join and separate, endpoint connections are re-derived on the next update */
+  bool topologyDirty = true;
+
+  /* Every cable is drawn as a rope, stepped in render and re-pinned only when some connector or component moved */
+  RopeSimulation ropes;
+  std::vector<RopeSimulation::Obstacle> obstacles;
+  bool ropesDirty = true;
+
+  /*
+   * Connectors joined directly or through cables form a chain. Chains are
+   * merged as connectors are joined and rebuilt lazily after a separation,
+   * each knows the (at most two) endpoint connectors at its ends.
+   */
+  DisjointSets chains;
+  std::vector<std::array<EndpointConnector*, 2>> chainEnds;
+  bool chainsDirty = false;
 
   void join(Connector* a, Connector* b, bool internal = false);
   void separate(Connector* a, Connector* b, bool internal = false);
 
+  void registerConnector(Connector* c);
+  void unregisterConnector(Connector* c);
+
+  void uniteChains(Connector* a, Connector* b);
+  void rebuildChains();
+
+  PositionHandle acquirePosition(glm::vec2 value);
+  PositionHandle sharePosition(PositionHandle handle);
+  void releasePosition(PositionHandle handle);
+
   EndpointConnector* findOther(EndpointConnector* connector);
+
+  /* Sets the rope length of c's cable from where its ends are now, c may be any connector */
+  void fitRope(Connector* c);
 };
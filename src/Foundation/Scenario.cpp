@@ -0,0 +1,91 @@
+#include <Foundation/Scenario.hpp>
+
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+
+#include <fmt/format.h>
+#include <json.hpp>
+
+#include <Foundation/Universe.hpp>
+#include <Foundation/Infrastructures/Wiring.hpp>
+#include <Foundation/Infrastructures/Wireless.hpp>
+#include <Foundation/Infrastructures/Manual.hpp>
+#include <Foundation/Systems/Video.hpp>
+#include <Foundation/Systems/Energy.hpp>
+#include <Foundation/Systems/Text.hpp>
+#include <Foundation/Systems/Data.hpp>
+#include <Foundation/Components/CPU.hpp>
+#include <Foundation/Components/Terminal.hpp>
+#include <Foundation/Components/Monitor.hpp>
+#include <Foundation/Components/Camera.hpp>
+#include <Foundation/Components/Generator.hpp>
+#include <Foundation/Components/Lamp.hpp>
+#include <Foundation/Components/Splitter.hpp>
+#include <Foundation/Components/Switch.hpp>
+
+namespace {
+  using Factory = std::function<void(Universe&, const json&)>;
+
+  template <typename T>
+  Factory factory() {
+    return [](Universe& universe, const json&) {
+      universe.add<T>();
+    };
+  }
+
+  const std::unordered_map<std::string, Factory> factories {
+      { "monitor",   factory<Monitor>() },
+      { "camera",    factory<Camera>() },
+      { "generator", factory<Generator>() },
+      { "lamp",      factory<Lamp>() },
+      { "terminal",  factory<Terminal>() },
+      { "splitter",  factory<Splitter>() },
+      { "switch",    factory<Switch>() },
+      {
+          "cpu", [](Universe& universe, const json& description) {
+            CPU* cpu = universe.add<CPU>();
+            if (description.count("program") != 0) {
+              cpu->run(CPU::compile(description["program"].get<std::string>()));
+            }
+          },
+      },
+  };
+}
+
+void loadScenario(Universe& universe, const fs::path& path) {
+  std::ifstream inf { path };
+  if (!inf) {
+    throw std::runtime_error { fmt::format("Could not open scenario '{}'", path.string()) };
+  }
+
+  json scenario;
+  inf >> scenario;
+
+  universe.add<Wireless>();
+  universe.add<Manual>();
+  universe.add<Wiring>();
+
+  universe.add<VideoSystem>();
+  universe.add<EnergySystem>();
+  universe.add<TextSystem>();
+  universe.add<DataSystem>();
+
+  for (auto& description : scenario["components"]) {
+    std::string type = description["type"];
+
+    auto it = factories.find(type);
+    if (it == factories.end()) {
+      throw std::runtime_error { fmt::format("Unknown component type '{}'", type) };
+    }
+
+    size_t count = description.count("count") != 0 ? description["count"].get<size_t>() : 1;
+    for (size_t i = 0; i < count; i++) {
+      it->second(universe, description);
+    }
+  }
+
+  if (scenario.count("connections") != 0) {
+    universe.infrastructure<Manual>().load(scenario["connections"]);
+  }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Util/Filesystem.hpp>
+
+class Universe;
+
+/*
+ * Populates an empty universe from a scenario file:
+ *
+ *   {
+ *     "components": [ { "type": "lamp", "count": 2 }, { "type": "cpu", "program": "..." } ],
+ *     "connections": [ ... ]
+ *   }
+ *
+ * Connections use the same format as Manual::save.
+ */
+void loadScenario(Universe& universe, const fs::path& path);
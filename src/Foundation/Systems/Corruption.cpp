@@ -0,0 +1,208 @@
+#include <Foundation/Systems/Corruption.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CORRUPTION_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+  constexpr uint32_t opaque = 0xFF000000u;
+
+  /* Decides pixels b and half + b of a chunk from a single block, used by every tail loop */
+  uint32_t scalarBlock(const Philox& random, const CorruptionChunk& chunk, const uint32_t* in, uint32_t* out, uint32_t count, uint32_t b) {
+    uint32_t half = (count + 1) / 2;
+    uint64_t lo = uint64_t(chunk.stream) << 32 | (chunk.firstBlock + b);
+    Philox::Block w = random(Philox::counter(chunk.tick, lo));
+
+    uint32_t hits = 0;
+    bool hit = w[0] < chunk.threshold;
+    out[b] = hit ? w[1] | opaque : in[b];
+    hits += hit;
+
+    if (half + b < count) {
+      hit = w[2] < chunk.threshold;
+      out[half + b] = hit ? w[3] | opaque : in[half + b];
+      hits += hit;
+    }
+    return hits;
+  }
+
+  uint32_t runScalar(const Philox& random, const CorruptionChunk& chunk, const uint32_t* in, uint32_t* out, uint32_t count) {
+    uint32_t half = (count + 1) / 2;
+    uint32_t hits = 0;
+    for (uint32_t b = 0; b < half; b++) {
+      hits += scalarBlock(random, chunk, in, out, count, b);
+    }
+    return hits;
+  }
+
+#ifdef CORRUPTION_X86
+  /*
+   * Both vector kernels run the Philox rounds on one block per 32-bit lane.
+   * mul_epu32 only multiplies even lanes, so odd lanes are shifted down and
+   * multiplied separately, then low and high halves are put back in place.
+   */
+  __attribute__((target("sse2")))
+  inline __m128i mulSse2(__m128i a, __m128i m, __m128i* hi) {
+    const __m128i evenLanes = _mm_set_epi32(0, -1, 0, -1);
+    __m128i even = _mm_mul_epu32(a, m);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+    *hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(evenLanes, odd));
+    return _mm_or_si128(_mm_and_si128(even, evenLanes), _mm_slli_epi64(odd, 32));
+  }
+
+  __attribute__((target("sse2")))
+  uint32_t runSse2(const Philox& random, const CorruptionChunk& chunk, const uint32_t* in, uint32_t* out, uint32_t count) {
+    constexpr uint32_t lanes = 4;
+    uint32_t half = (count + 1) / 2;
+    uint32_t paired = count / 2;
+
+    const __m128i m0 = _mm_set1_epi32(int(Philox::M0));
+    const __m128i m1 = _mm_set1_epi32(int(Philox::M1));
+    const __m128i sign = _mm_set1_epi32(INT32_MIN);
+    const __m128i threshold = _mm_xor_si128(_mm_set1_epi32(int(chunk.threshold)), sign);
+    const __m128i alpha = _mm_set1_epi32(int(opaque));
+    __m128i hits = _mm_setzero_si128();
+
+    uint32_t b = 0;
+    for (; b + lanes <= paired; b += lanes) {
+      __m128i c0 = _mm_add_epi32(_mm_set1_epi32(int(chunk.firstBlock + b)), _mm_setr_epi32(0, 1, 2, 3));
+      __m128i c1 = _mm_set1_epi32(int(chunk.stream));
+      __m128i c2 = _mm_set1_epi32(int(uint32_t(chunk.tick)));
+      __m128i c3 = _mm_set1_epi32(int(uint32_t(chunk.tick >> 32)));
+      uint32_t k0 = random.key[0];
+      uint32_t k1 = random.key[1];
+
+      for (int round = 0; round < Philox::rounds; round++) {
+        __m128i hi0;
+        __m128i hi1;
+        __m128i lo0 = mulSse2(c0, m0, &hi0);
+        __m128i lo1 = mulSse2(c2, m1, &hi1);
+        c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(int(k0)));
+        c1 = lo1;
+        c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(int(k1)));
+        c3 = lo0;
+        k0 += Philox::W0;
+        k1 += Philox::W1;
+      }
+
+      /* Unsigned compare through the sign bit, SSE2 only compares signed */
+      __m128i hitA = _mm_cmplt_epi32(_mm_xor_si128(c0, sign), threshold);
+      __m128i hitB = _mm_cmplt_epi32(_mm_xor_si128(c2, sign), threshold);
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + b));
+      __m128i bb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + half + b));
+      a = _mm_or_si128(_mm_and_si128(hitA, _mm_or_si128(c1, alpha)), _mm_andnot_si128(hitA, a));
+      bb = _mm_or_si128(_mm_and_si128(hitB, _mm_or_si128(c3, alpha)), _mm_andnot_si128(hitB, bb));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + b), a);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + half + b), bb);
+
+      hits = _mm_sub_epi32(_mm_sub_epi32(hits, hitA), hitB);
+    }
+
+    alignas(16) uint32_t counts[lanes];
+    _mm_store_si128(reinterpret_cast<__m128i*>(counts), hits);
+    uint32_t total = counts[0] + counts[1] + counts[2] + counts[3];
+
+    for (; b < half; b++) {
+      total += scalarBlock(random, chunk, in, out, count, b);
+    }
+    return total;
+  }
+
+  __attribute__((target("avx2")))
+  inline __m256i mulAvx2(__m256i a, __m256i m, __m256i* hi) {
+    const __m256i evenLanes = _mm256_set1_epi64x(0xFFFFFFFF);
+    __m256i even = _mm256_mul_epu32(a, m);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    *hi = _mm256_or_si256(_mm256_srli_epi64(even, 32), _mm256_andnot_si256(evenLanes, odd));
+    return _mm256_or_si256(_mm256_and_si256(even, evenLanes), _mm256_slli_epi64(odd, 32));
+  }
+
+  __attribute__((target("avx2")))
+  uint32_t runAvx2(const Philox& random, const CorruptionChunk& chunk, const uint32_t* in, uint32_t* out, uint32_t count) {
+    constexpr uint32_t lanes = 8;
+    uint32_t half = (count + 1) / 2;
+    uint32_t paired = count / 2;
+
+    const __m256i m0 = _mm256_set1_epi32(int(Philox::M0));
+    const __m256i m1 = _mm256_set1_epi32(int(Philox::M1));
+    const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+    const __m256i threshold = _mm256_xor_si256(_mm256_set1_epi32(int(chunk.threshold)), sign);
+    const __m256i alpha = _mm256_set1_epi32(int(opaque));
+    __m256i hits = _mm256_setzero_si256();
+
+    uint32_t b = 0;
+    for (; b + lanes <= paired; b += lanes) {
+      __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(int(chunk.firstBlock + b)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+      __m256i c1 = _mm256_set1_epi32(int(chunk.stream));
+      __m256i c2 = _mm256_set1_epi32(int(uint32_t(chunk.tick)));
+      __m256i c3 = _mm256_set1_epi32(int(uint32_t(chunk.tick >> 32)));
+      uint32_t k0 = random.key[0];
+      uint32_t k1 = random.key[1];
+
+      for (int round = 0; round < Philox::rounds; round++) {
+        __m256i hi0;
+        __m256i hi1;
+        __m256i lo0 = mulAvx2(c0, m0, &hi0);
+        __m256i lo1 = mulAvx2(c2, m1, &hi1);
+        c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(int(k0)));
+        c1 = lo1;
+        c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(int(k1)));
+        c3 = lo0;
+        k0 += Philox::W0;
+        k1 += Philox::W1;
+      }
+
+      __m256i hitA = _mm256_cmpgt_epi32(threshold, _mm256_xor_si256(c0, sign));
+      __m256i hitB = _mm256_cmpgt_epi32(threshold, _mm256_xor_si256(c2, sign));
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + b));
+      __m256i bb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + half + b));
+      a = _mm256_blendv_epi8(a, _mm256_or_si256(c1, alpha), hitA);
+      bb = _mm256_blendv_epi8(bb, _mm256_or_si256(c3, alpha), hitB);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + b), a);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + half + b), bb);
+
+      hits = _mm256_sub_epi32(_mm256_sub_epi32(hits, hitA), hitB);
+    }
+
+    alignas(32) uint32_t counts[lanes];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(counts), hits);
+    uint32_t total = 0;
+    for (uint32_t c : counts) {
+      total += c;
+    }
+
+    for (; b < half; b++) {
+      total += scalarBlock(random, chunk, in, out, count, b);
+    }
+    return total;
+  }
+#endif
+
+  const CorruptionKernel scalar { "scalar", runScalar };
+#ifdef CORRUPTION_X86
+  const CorruptionKernel sse2 { "sse2", runSse2 };
+  const CorruptionKernel avx2 { "avx2", runAvx2 };
+#endif
+}
+
+const CorruptionKernel& corruptionKernel() {
+  static const CorruptionKernel* best = corruptionKernels().back();
+  return *best;
+}
+
+std::vector<const CorruptionKernel*> corruptionKernels() {
+  std::vector<const CorruptionKernel*> kernels { &scalar };
+
+#ifdef CORRUPTION_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2")) {
+    kernels.push_back(&sse2);
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    kernels.push_back(&avx2);
+  }
+#endif
+
+  return kernels;
+}
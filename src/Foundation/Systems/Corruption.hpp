@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Util/Philox.hpp>
+
+/*
+ * Per-pixel video corruption in bulk. A kernel copies count pixels from in
+ * to out, replacing each with a random opaque colour with probability
+ * threshold / 2^32, and returns the number of pixels replaced.
+ *
+ * Block b of a chunk is the Philox counter (firstBlock + b, stream, tick)
+ * and decides pixels b and half + b, half = (count + 1) / 2, so vector
+ * lanes read and write contiguous pixels. Every kernel produces the same
+ * bits, only the instruction set differs.
+ */
+struct CorruptionChunk {
+  uint32_t firstBlock;
+  uint32_t stream;
+  uint64_t tick;
+  uint32_t threshold;
+};
+
+struct CorruptionKernel {
+  const char* isa;
+  uint32_t (*run)(const Philox& random, const CorruptionChunk& chunk, const uint32_t* in, uint32_t* out, uint32_t count);
+};
+
+/* Fastest kernel supported by this CPU, chosen once on first use */
+const CorruptionKernel& corruptionKernel();
+
+/* Every kernel this CPU can run, scalar first */
+std::vector<const CorruptionKernel*> corruptionKernels();
@@ -0,0 +1,81 @@
+#include <Foundation/Systems/Data.hpp>
+
+#include <fmt/format.h>
+#include <imgui.h>
+
+std::string toString(const Datum& d) {
+  switch (d.type) {
+    case Datum::Type::Int:
+      return fmt::format("{}", d.toInt());
+    case Datum::Type::Float:
+      return fmt::format("{}", d.value.x);
+    case Datum::Type::Vec2:
+      return fmt::format("({}, {})", d.value.x, d.value.y);
+    case Datum::Type::Vec3:
+      return fmt::format("({}, {}, {})", d.value.x, d.value.y, d.value.z);
+  }
+  return {};
+}
+
+bool DataSystem::filter(const Connection& edge) const {
+  return edge.capabilities.data.enabled;
+}
+
+void DataSystem::update() {
+  exchange(this->edges, this->senders, [](Endpoint* p) -> Mailbox<Datum>* {
+    return p->dataMailbox;
+  }, [this](Connection& edge) {
+    this->swap(edge);
+  });
+}
+
+void DataSystem::swap(Connection& edge) {
+  DataMailbox* from = edge.from->dataMailbox;
+  DataMailbox* to = edge.to->dataMailbox;
+
+  if (from == nullptr || to == nullptr) {
+    return;
+  }
+
+  for (const Datum& d : from->staged) {
+    to->deliver(d);
+  }
+}
+
+void DataSystem::attach(Endpoint* port) {
+  if (port->capabilities.data.enabled) {
+    auto& mailbox = this->mailboxes[port];
+    mailbox = std::make_unique<DataMailbox>(port->capabilities.data.queue);
+    port->dataMailbox = mailbox.get();
+  }
+}
+
+void DataSystem::detach(Endpoint* port) {
+  port->dataMailbox = nullptr;
+  this->mailboxes.erase(port);
+}
+
+SendStatus DataSystem::send(Endpoint* port, Datum d) {
+  if (port->dataMailbox == nullptr) {
+    return SendStatus::Unsupported;
+  }
+  return port->dataMailbox->send(std::move(d));
+}
+
+std::optional<Datum> DataSystem::receive(Endpoint* port) {
+  if (port->dataMailbox == nullptr) {
+    return std::nullopt;
+  }
+  return port->dataMailbox->inbox.pop();
+}
+
+void DataSystem::UI() {
+  System::UI();
+
+  if (ImGui::TreeNode("Ports")) {
+    for (auto& pair : this->mailboxes) {
+      drawQueueStatistics(pair.first, *pair.second);
+    }
+    ImGui::TreePop();
+  }
+}
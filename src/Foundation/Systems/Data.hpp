@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Foundation/Systems/System.hpp>
+#include <Foundation/Systems/Mailbox.hpp>
+
+/* Fixed-size value carried by DataSystem, integers are stored exactly in x */
+struct Datum {
+  enum class Type : uint8_t {
+    Int,
+    Float,
+    Vec2,
+    Vec3,
+  };
+
+  Datum() = default;
+  Datum(int16_t i) : type { Type::Int }, value { float(i), 0.0f, 0.0f } { }
+  Datum(float f) : type { Type::Float }, value { f, 0.0f, 0.0f } { }
+  Datum(glm::vec2 v) : type { Type::Vec2 }, value { v.x, v.y, 0.0f } { }
+  Datum(glm::vec3 v) : type { Type::Vec3 }, value { v } { }
+
+  /* Scalars convert between each other, vectors yield their first component */
+  int16_t toInt() const {
+    return int16_t(value.x);
+  }
+
+  Type type = Type::Int;
+  glm::vec3 value { 0.0f };
+};
+
+std::string toString(const Datum& d);
+
+struct DataMailbox : public Mailbox<Datum> {
+  using Mailbox::Mailbox;
+};
+
+/*
+ * Numeric traffic between components. Works like TextSystem but carries
+ * Datum values, so a message costs a 16 byte copy instead of formatting,
+ * a heap string and parsing.
+ */
+struct DataSystem : public System {
+  explicit DataSystem(Universe* u)
+    : System { u, "Data" }
+  { }
+
+  bool filter(const Connection& edge) const override;
+  void swap(Connection& edge) override;
+
+  void attach(Endpoint* port) override;
+  void detach(Endpoint* port) override;
+
+  void update() override;
+  void UI() override;
+
+  SendStatus send(Endpoint* port, Datum d);
+  std::optional<Datum> receive(Endpoint* port);
+
+  /* Calls visit(const Datum&) on every pending value in order, returns how many there were */
+  template <typename F>
+  size_t drain(Endpoint* port, F&& visit) {
+    if (port->dataMailbox == nullptr) {
+      return 0;
+    }
+    return port->dataMailbox->inbox.drain([&visit](const Datum& d) {
+      visit(d);
+    });
+  }
+
+private:
+  std::unordered_map<Endpoint*, std::unique_ptr<DataMailbox>> mailboxes;
+
+  /* Mailboxes collected during the current update */
+  std::vector<Mailbox<Datum>*> senders;
+};
@@ -1,10 +1,12 @@
 #include <Foundation/Systems/Energy.hpp>
 
 #include <algorithm>
-#include <queue>
+#include <limits>
 
 #include <Foundation/Universe.hpp>
 
+#include <imgui.h>
+
 bool EnergySystem::filter(const Connection& edge) const {
   return edge.capabilities.energy.enabled;
 }
@@ -12,6 +14,25 @@ bool EnergySystem::filter(const Connection& edge) const {
 void EnergySystem::swap(Connection& edge) {
 }
 
+void EnergySystem::connected(Connection& edge) {
+  System::connected(edge);
+  if (filter(edge)) {
+    invalidate();
+  }
+}
+
+void EnergySystem::disconnected(Connection& edge) {
+  System::disconnected(edge);
+  if (filter(edge)) {
+    invalidate();
+  }
+}
+
+void EnergySystem::changed(Connection& edge) {
+  System::changed(edge);
+  invalidate();
+}
+
 void EnergySystem::produce(Endpoint* port, float energy) {
   sendBuffers[port] += energy;
 }
@@ -22,44 +43,103 @@ float EnergySystem::consume(Endpoint* port, float req) {
   return res;
 }
 
+void EnergySystem::invalidate() {
+  dirty = true;
+}
+
 void EnergySystem::update() {
+  if (dirty.exchange(false)) {
+    network.compile(edges);
+    routers.resize(network.grids.size());
+  }
+
   for (auto& pair : recvBuffers) {
-    Endpoint* p = pair.first;
-    recvBuffers[p] = 0;
+    pair.second = 0;
   }
 
+  flows.assign(network.edgeCount(), 0.0f);
+  delivered.assign(network.size(), 0.0f);
+  supply.clear();
+
   for (auto& pair : sendBuffers) {
     Endpoint* p = pair.first;
+    float e = pair.second;
+    pair.second = 0;
+
+    if (e == 0.0f) {
+      continue;
+    }
+
+    /* Energy produced on an unconnected port goes nowhere */
+    if (auto source = network.node(p)) {
+      supply.emplace_back(*source, e);
+    }
+  }
+
+  /* Sorted so sums don't depend on hash map order, which also groups the supply by grid */
+  std::sort(supply.begin(), supply.end());
 
-    std::queue<std::pair<float, Endpoint*>> queue;
-    queue.emplace(sendBuffers[p], p);
-
-    // TODO: This loops indefinitely when circuit is not complete
-    while (!queue.empty()) {
-      float e = queue.front().first;
-      Endpoint* p = queue.front().second;
-
-      for (Connection& c : universe->connections) {
-        if (c.from == p) {
-          p = c.to;
-          break;
-        }
-      }
-
-      std::vector<std::pair<float, Endpoint*>> neighbours = p->component->redistributeEnergy(p);
-
-      if (neighbours.empty()) {
-        recvBuffers[p] += e;
-      }
-      else {
-        for (auto& pp : neighbours) {
-          queue.emplace(pp.first * e, pp.second);
-        }
-      }
-
-      queue.pop();
+  batches.clear();
+  for (uint32_t i = 0; i < supply.size();) {
+    uint32_t grid = network.nodeGrids[supply[i].first];
+    uint32_t j = i + 1;
+    while (j < supply.size() && network.nodeGrids[supply[j].first] == grid) {
+      j++;
     }
+    batches.push_back(Batch { grid, i, j });
+    i = j;
+  }
+
+  /* Grids only touch their own node and edge ranges, so they're solved concurrently */
+  universe->pool.parallelFor(batches.size(), [this](size_t i) {
+    solve(batches[i]);
+  });
+
+  for (uint32_t v = 0; v < delivered.size(); v++) {
+    if (delivered[v] > 0.0f) {
+      recvBuffers[network.endpoint(v)] += delivered[v];
+    }
+  }
+
+  saturated.clear();
+  for (size_t e = 0; e < flows.size(); e++) {
+    float capacity = network.edgeCapacities[e];
+    if (capacity != std::numeric_limits<float>::infinity() && flows[e] >= capacity * saturationThreshold) {
+      saturated.push_back(network.edgeConnections[e]);
+    }
+  }
+}
+
+void EnergySystem::solve(const Batch& batch) {
+  const EnergyNetwork::Grid& grid = network.grids[batch.grid];
+  gsl::span<const std::pair<uint32_t, float>> gridSupply { supply.data() + batch.supplyBegin, batch.supplyEnd - batch.supplyBegin };
+
+  for (auto& pair : gridSupply) {
+    auto& response = network.response(pair.first);
+
+    for (auto& sink : response.sinks) {
+      delivered[sink.first] += pair.second * sink.second;
+    }
+    for (auto& edge : response.edges) {
+      flows[edge.first] += pair.second * edge.second;
+    }
+  }
+
+  /* Only route around throughput limits when the proportional split exceeds one */
+  bool overloaded = false;
+  for (uint32_t e = grid.edgeBegin; e < grid.edgeEnd && !overloaded; e++) {
+    overloaded = flows[e] > network.edgeCapacities[e];
+  }
+  if (overloaded) {
+    routers[batch.grid].route(network, grid, gridSupply, flows, delivered);
+  }
+}
+
+void EnergySystem::UI() {
+  System::UI();
 
-    sendBuffers[p] = 0;
+  ImGui::Text("Saturated links: %zu", saturated.size());
+  for (Connection* c : saturated) {
+    ImGui::BulletText("%s -> %s (%.1f)", c->from->name().c_str(), c->to->name().c_str(), c->capabilities.energy.throughput);
   }
 }
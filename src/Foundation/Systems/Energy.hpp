@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <unordered_map>
+#include <vector>
 
 #include <Foundation/Systems/System.hpp>
+#include <Foundation/Systems/EnergyNetwork.hpp>
+#include <Foundation/Systems/EnergyRouter.hpp>
 
 class EnergySystem : public System {
   using Buffer = float;
@@ -14,11 +18,46 @@ public:
   bool filter(const Connection& edge) const override;
   void swap(Connection& edge) override;
 
+  void connected(Connection& edge) override;
+  void disconnected(Connection& edge) override;
+  void changed(Connection& edge) override;
+
   void update() override;
+  void UI() override;
 
   void produce(Endpoint* port, float energy);
   float consume(Endpoint* port, float req);
 
+  /* Forces a recompile, for components whose redistribution changed */
+  void invalidate();
+
   std::unordered_map<Endpoint*, Buffer> sendBuffers;
   std::unordered_map<Endpoint*, Buffer> recvBuffers;
+
+  /* Connections carrying (nearly) their full throughput during the last update */
+  std::vector<Connection*> saturated;
+
+private:
+  /* Supply of one grid, a range of the sorted supply */
+  struct Batch {
+    uint32_t grid;
+    uint32_t supplyBegin, supplyEnd;
+  };
+
+  void solve(const Batch& batch);
+
+  /* Fraction of throughput at which a link counts as saturated */
+  static constexpr float saturationThreshold = 0.999f;
+
+  EnergyNetwork network;
+  /* One per grid, so grids can be routed concurrently */
+  std::vector<EnergyRouter> routers;
+
+  /* Per-update scratch, kept to avoid reallocating */
+  std::vector<float> flows;
+  std::vector<float> delivered;
+  EnergyRouter::Supply supply;
+  std::vector<Batch> batches;
+
+  std::atomic_bool dirty = true;
 };
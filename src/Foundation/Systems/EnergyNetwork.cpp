@@ -0,0 +1,226 @@
+#include <Foundation/Systems/EnergyNetwork.hpp>
+
+#include <algorithm>
+
+#include <Foundation/Components/Component.hpp>
+#include <Util/DisjointSets.hpp>
+
+namespace {
+  /* Amounts below this fraction of a unit are dropped */
+  constexpr float epsilon = 1e-6f;
+  /* Energy circulating in a loop without sinks is dropped after this many visits per node */
+  constexpr size_t maxVisitsPerNode = 64;
+}
+
+void EnergyNetwork::compile(const std::vector<Connection*>& edges) {
+  this->nodes.clear();
+  this->indices.clear();
+  this->responses.clear();
+
+  /* Intern edge endpoints first, then every port they redistribute to */
+  for (Connection* c : edges) {
+    intern(c->from);
+    intern(c->to);
+  }
+
+  std::vector<std::vector<std::pair<float, Endpoint*>>> redistributions;
+  for (size_t i = 0; i < this->nodes.size(); i++) {
+    Endpoint* p = this->nodes[i];
+    redistributions.push_back(p->component->redistributeEnergy(p));
+
+    for (auto& pair : redistributions.back()) {
+      intern(pair.second);
+    }
+  }
+
+  size_t n = this->nodes.size();
+
+  /* Find grids, ports of one component are joined through its redistribution */
+  DisjointSets sets { n };
+  for (Connection* c : edges) {
+    sets.unite(this->indices[c->from], this->indices[c->to]);
+  }
+  for (uint32_t v = 0; v < n; v++) {
+    for (auto& pair : redistributions[v]) {
+      sets.unite(v, this->indices[pair.second]);
+    }
+  }
+
+  /* Number grids by first appearance and sort nodes by grid, keeping their order within it */
+  std::vector<uint32_t> rootGrids(n, UINT32_MAX);
+  std::vector<uint32_t> grids;
+  std::vector<uint32_t> counts;
+  for (uint32_t v = 0; v < n; v++) {
+    uint32_t& g = rootGrids[sets.find(v)];
+    if (g == UINT32_MAX) {
+      g = counts.size();
+      counts.push_back(0);
+    }
+    grids.push_back(g);
+    counts[g]++;
+  }
+
+  std::vector<uint32_t> starts(counts.size() + 1, 0);
+  for (size_t g = 0; g < counts.size(); g++) {
+    starts[g + 1] = starts[g] + counts[g];
+  }
+
+  std::vector<Endpoint*> sorted(n);
+  std::vector<std::vector<std::pair<float, Endpoint*>>> sortedRedistributions(n);
+  std::vector<uint32_t> cursors(starts.begin(), starts.end() - 1);
+  for (uint32_t v = 0; v < n; v++) {
+    uint32_t ix = cursors[grids[v]]++;
+    sorted[ix] = this->nodes[v];
+    sortedRedistributions[ix] = std::move(redistributions[v]);
+  }
+
+  this->nodes = std::move(sorted);
+  redistributions = std::move(sortedRedistributions);
+  for (uint32_t v = 0; v < n; v++) {
+    this->indices[this->nodes[v]] = v;
+  }
+
+  this->nodeGrids.resize(n);
+  for (uint32_t g = 0; g < counts.size(); g++) {
+    std::fill(this->nodeGrids.begin() + starts[g], this->nodeGrids.begin() + starts[g + 1], g);
+  }
+
+  /* Outgoing edges */
+  std::vector<std::vector<Connection*>> outgoing(n);
+  for (Connection* c : edges) {
+    outgoing[this->indices[c->from]].push_back(c);
+  }
+
+  this->edgeOffsets.assign(1, 0);
+  this->edgeSources.clear();
+  this->edgeTargets.clear();
+  this->edgeConnections.clear();
+  this->edgeCapacities.clear();
+  for (uint32_t v = 0; v < n; v++) {
+    for (Connection* c : outgoing[v]) {
+      this->edgeSources.push_back(v);
+      this->edgeTargets.push_back(this->indices[c->to]);
+      this->edgeConnections.push_back(c);
+      this->edgeCapacities.push_back(c->capabilities.energy.throughput);
+    }
+    this->edgeOffsets.push_back(this->edgeTargets.size());
+  }
+
+  /* Redistribution coefficients */
+  this->redistributionOffsets.assign(1, 0);
+  this->redistributionTargets.clear();
+  this->redistributionFactors.clear();
+  for (auto& redistribution : redistributions) {
+    for (auto& pair : redistribution) {
+      this->redistributionTargets.push_back(this->indices[pair.second]);
+      this->redistributionFactors.push_back(pair.first);
+    }
+    this->redistributionOffsets.push_back(this->redistributionTargets.size());
+  }
+
+  this->grids.clear();
+  for (size_t g = 0; g < counts.size(); g++) {
+    this->grids.push_back(Grid {
+        starts[g], starts[g + 1],
+        this->edgeOffsets[starts[g]], this->edgeOffsets[starts[g + 1]],
+    });
+  }
+
+  this->responses.resize(n);
+}
+
+std::optional<uint32_t> EnergyNetwork::node(Endpoint* port) const {
+  auto it = this->indices.find(port);
+  if (it == this->indices.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+const EnergyNetwork::Response& EnergyNetwork::response(uint32_t source) {
+  if (this->responses[source]) {
+    return *this->responses[source];
+  }
+
+  /* Work arrays only span the source's grid, indexed relative to its start */
+  const Grid& grid = this->grid(source);
+  uint32_t n = grid.nodeEnd - grid.nodeBegin;
+  uint32_t m = grid.edgeEnd - grid.edgeBegin;
+
+  std::vector<float> residual(n, 0.0f);
+  std::vector<float> delivered(n, 0.0f);
+  std::vector<float> carried(m, 0.0f);
+  std::vector<bool> queued(n, false);
+  std::vector<uint32_t> worklist;
+
+  /* Sends amount out of a departure node, energy leaving an unconnected port is lost */
+  auto emit = [&](uint32_t from, float amount) {
+    uint32_t begin = this->edgeOffsets[from];
+    uint32_t end = this->edgeOffsets[from + 1];
+
+    for (uint32_t e = begin; e < end; e++) {
+      uint32_t to = this->edgeTargets[e] - grid.nodeBegin;
+      carried[e - grid.edgeBegin] += amount / float(end - begin);
+      residual[to] += amount / float(end - begin);
+
+      if (!queued[to] && residual[to] > epsilon) {
+        queued[to] = true;
+        worklist.push_back(to);
+      }
+    }
+  };
+
+  emit(source, 1.0f);
+
+  /*
+   * Push residual energy through the network until it settles in sinks.
+   * Energy revisiting a node simply accumulates there, so cycles converge
+   * geometrically as long as some of it leaks into a sink.
+   */
+  size_t budget = maxVisitsPerNode * std::max<size_t>(n, 1);
+  for (size_t head = 0; head < worklist.size() && budget > 0; head++, budget--) {
+    uint32_t v = worklist[head];
+    float amount = residual[v];
+    residual[v] = 0.0f;
+    queued[v] = false;
+
+    uint32_t begin = this->redistributionOffsets[grid.nodeBegin + v];
+    uint32_t end = this->redistributionOffsets[grid.nodeBegin + v + 1];
+
+    if (begin == end) {
+      delivered[v] += amount;
+      continue;
+    }
+
+    for (uint32_t r = begin; r < end; r++) {
+      emit(this->redistributionTargets[r], amount * this->redistributionFactors[r]);
+    }
+  }
+
+  Response response;
+  for (uint32_t v = 0; v < n; v++) {
+    if (delivered[v] > epsilon) {
+      response.sinks.emplace_back(grid.nodeBegin + v, delivered[v]);
+    }
+  }
+  for (uint32_t e = 0; e < m; e++) {
+    if (carried[e] > epsilon) {
+      response.edges.emplace_back(grid.edgeBegin + e, carried[e]);
+    }
+  }
+
+  this->responses[source] = std::move(response);
+  return *this->responses[source];
+}
+
+uint32_t EnergyNetwork::intern(Endpoint* port) {
+  auto it = this->indices.find(port);
+  if (it != this->indices.end()) {
+    return it->second;
+  }
+
+  uint32_t ix = this->nodes.size();
+  this->nodes.push_back(port);
+  this->indices.emplace(port, ix);
+  return ix;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Foundation/Infrastructures/Infrastructure.hpp>
+
+/*
+ * Energy-carrying connections compiled into flat adjacency arrays.
+ *
+ * Every port is a node. Energy leaving a node travels along its outgoing
+ * edges (split evenly if there are several) and arrives at the edge
+ * targets, where the owning component redistributes it to its other ports
+ * using the coefficients from Component::redistributeEnergy. Nodes that
+ * don't redistribute are sinks and keep what arrives.
+ *
+ * Nodes are ordered by grid (connected component), so each grid owns a
+ * contiguous range of nodes and edges and can be solved on its own.
+ */
+class EnergyNetwork {
+public:
+  struct Response {
+    /* Fraction of one unit produced at the source that ends up in each sink */
+    std::vector<std::pair<uint32_t, float>> sinks;
+    /* Fraction of one unit produced at the source that travels along each edge */
+    std::vector<std::pair<uint32_t, float>> edges;
+  };
+
+  struct Grid {
+    uint32_t nodeBegin, nodeEnd;
+    uint32_t edgeBegin, edgeEnd;
+  };
+
+  void compile(const std::vector<Connection*>& edges);
+
+  std::optional<uint32_t> node(Endpoint* port) const;
+  Endpoint* endpoint(uint32_t node) const {
+    return nodes[node];
+  }
+
+  size_t size() const {
+    return nodes.size();
+  }
+
+  size_t edgeCount() const {
+    return edgeTargets.size();
+  }
+
+  bool isSink(uint32_t node) const {
+    return redistributionOffsets[node] == redistributionOffsets[node + 1];
+  }
+
+  const Grid& grid(uint32_t node) const {
+    return grids[nodeGrids[node]];
+  }
+
+  /*
+   * Proportional distribution of one unit produced at source, ignoring
+   * throughput. Safe to call concurrently for sources in different grids.
+   */
+  const Response& response(uint32_t source);
+
+  std::vector<Grid> grids;
+  std::vector<uint32_t> nodeGrids;
+
+  /* Outgoing edges, indexed by node */
+  std::vector<uint32_t> edgeOffsets;
+  std::vector<uint32_t> edgeSources;
+  std::vector<uint32_t> edgeTargets;
+  std::vector<Connection*> edgeConnections;
+  /* Capabilities::energy.throughput of each edge */
+  std::vector<float> edgeCapacities;
+
+  /* Redistribution from an arrival node to departure nodes of the same component */
+  std::vector<uint32_t> redistributionOffsets;
+  std::vector<uint32_t> redistributionTargets;
+  std::vector<float> redistributionFactors;
+
+private:
+  uint32_t intern(Endpoint* port);
+
+  std::vector<Endpoint*> nodes;
+  std::unordered_map<Endpoint*, uint32_t> indices;
+
+  std::vector<std::optional<Response>> responses;
+};
@@ -0,0 +1,165 @@
+#include <Foundation/Systems/EnergyRouter.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+  /* Residual capacity below this is treated as saturated */
+  constexpr float epsilon = 1e-6f;
+  constexpr float unlimited = std::numeric_limits<float>::infinity();
+}
+
+void EnergyRouter::route(const EnergyNetwork& network, const EnergyNetwork::Grid& grid, gsl::span<const std::pair<uint32_t, float>> supply,
+                         std::vector<float>& flows, std::vector<float>& delivered) {
+  /* Vertices are grid nodes relative to its start, followed by the source and sink */
+  uint32_t n = grid.nodeEnd - grid.nodeBegin;
+  uint32_t m = grid.edgeEnd - grid.edgeBegin;
+  uint32_t source = n;
+  uint32_t sink = n + 1;
+
+  this->reset(n + 2);
+
+  for (auto& pair : supply) {
+    this->addArc(source, pair.first - grid.nodeBegin, pair.second);
+  }
+
+  /* Edges only carry what the proportional split sends along them, up to their throughput */
+  this->edgeArcs.assign(m, none);
+  for (uint32_t e = 0; e < m; e++) {
+    uint32_t edge = grid.edgeBegin + e;
+    if (flows[edge] > epsilon) {
+      float capacity = std::min(flows[edge], network.edgeCapacities[edge]);
+      this->edgeArcs[e] = this->addArc(network.edgeSources[edge] - grid.nodeBegin, network.edgeTargets[edge] - grid.nodeBegin, capacity);
+    }
+  }
+
+  /* Components pass whatever arrives on to their other ports */
+  for (uint32_t v = 0; v < n; v++) {
+    uint32_t node = grid.nodeBegin + v;
+    for (uint32_t r = network.redistributionOffsets[node]; r < network.redistributionOffsets[node + 1]; r++) {
+      if (network.redistributionFactors[r] > 0.0f) {
+        this->addArc(v, network.redistributionTargets[r] - grid.nodeBegin, unlimited);
+      }
+    }
+  }
+
+  this->sinkArcs.assign(n, none);
+  for (uint32_t v = 0; v < n; v++) {
+    if (delivered[grid.nodeBegin + v] > epsilon) {
+      this->sinkArcs[v] = this->addArc(v, sink, delivered[grid.nodeBegin + v]);
+    }
+  }
+
+  while (this->buildLevels(source, sink)) {
+    this->blockingFlow(source, sink);
+  }
+
+  /* Flow on an arc is the residual of its reverse */
+  for (uint32_t e = 0; e < m; e++) {
+    uint32_t a = this->edgeArcs[e];
+    flows[grid.edgeBegin + e] = a == none ? 0.0f : this->arcResiduals[a ^ 1];
+  }
+  for (uint32_t v = 0; v < n; v++) {
+    uint32_t a = this->sinkArcs[v];
+    delivered[grid.nodeBegin + v] = a == none ? 0.0f : this->arcResiduals[a ^ 1];
+  }
+}
+
+void EnergyRouter::reset(size_t vertices) {
+  this->arcTargets.clear();
+  this->arcNext.clear();
+  this->arcResiduals.clear();
+  this->heads.assign(vertices, none);
+}
+
+uint32_t EnergyRouter::addArc(uint32_t from, uint32_t to, float capacity) {
+  uint32_t a = this->arcTargets.size();
+
+  this->arcTargets.push_back(to);
+  this->arcNext.push_back(this->heads[from]);
+  this->arcResiduals.push_back(capacity);
+  this->heads[from] = a;
+
+  this->arcTargets.push_back(from);
+  this->arcNext.push_back(this->heads[to]);
+  this->arcResiduals.push_back(0.0f);
+  this->heads[to] = a + 1;
+
+  return a;
+}
+
+bool EnergyRouter::buildLevels(uint32_t source, uint32_t sink) {
+  this->levels.assign(this->heads.size(), -1);
+  this->queue.clear();
+
+  this->levels[source] = 0;
+  this->queue.push_back(source);
+
+  for (size_t head = 0; head < this->queue.size(); head++) {
+    uint32_t v = this->queue[head];
+
+    for (uint32_t a = this->heads[v]; a != none; a = this->arcNext[a]) {
+      uint32_t w = this->arcTargets[a];
+      if (this->levels[w] < 0 && this->arcResiduals[a] > epsilon) {
+        this->levels[w] = this->levels[v] + 1;
+        this->queue.push_back(w);
+      }
+    }
+  }
+
+  return this->levels[sink] >= 0;
+}
+
+void EnergyRouter::blockingFlow(uint32_t source, uint32_t sink) {
+  this->cursors = this->heads;
+  this->path.clear();
+
+  /* Iterative DFS, long cable chains would overflow the worker stacks otherwise */
+  uint32_t v = source;
+  while (true) {
+    if (v == sink) {
+      float amount = unlimited;
+      for (uint32_t a : this->path) {
+        amount = std::min(amount, this->arcResiduals[a]);
+      }
+      for (uint32_t a : this->path) {
+        this->arcResiduals[a] -= amount;
+        this->arcResiduals[a ^ 1] += amount;
+      }
+
+      /* Retreat to the tail of the first saturated arc */
+      auto saturated = std::find_if(this->path.begin(), this->path.end(), [this](uint32_t a) {
+        return this->arcResiduals[a] <= epsilon;
+      });
+      this->path.erase(saturated, this->path.end());
+      v = this->path.empty() ? source : this->arcTargets[this->path.back()];
+      continue;
+    }
+
+    uint32_t& a = this->cursors[v];
+    while (a != none) {
+      uint32_t w = this->arcTargets[a];
+      if (this->arcResiduals[a] > epsilon && this->levels[w] == this->levels[v] + 1) {
+        break;
+      }
+      a = this->arcNext[a];
+    }
+
+    if (a != none) {
+      this->path.push_back(a);
+      v = this->arcTargets[a];
+      continue;
+    }
+
+    /* Dead end, nothing more gets through v in this phase */
+    this->levels[v] = -1;
+    if (this->path.empty()) {
+      break;
+    }
+
+    uint32_t back = this->path.back();
+    this->path.pop_back();
+    v = this->arcTargets[back ^ 1];
+    this->cursors[v] = this->arcNext[this->cursors[v]];
+  }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gsl/span>
+
+#include <Foundation/Systems/EnergyNetwork.hpp>
+
+/*
+ * Caps the proportional distribution of an EnergyNetwork at each edge's
+ * throughput. Every edge may carry at most the smaller of its throughput
+ * and its proportional share, and a maximum flow from the producers to the
+ * sinks is found with Dinic's algorithm. Energy that can't get through a
+ * saturated link is lost instead of being pushed past another edge's share.
+ *
+ * Buffers are reused between calls, so routing doesn't allocate once warm.
+ * An instance must not route two grids at the same time.
+ */
+class EnergyRouter {
+public:
+  using Supply = std::vector<std::pair<uint32_t, float>>;
+
+  /*
+   * Routes the supply of a single grid. flows and delivered hold the
+   * proportional amounts and are overwritten with the routed ones, only
+   * within the grid's node and edge ranges.
+   */
+  void route(const EnergyNetwork& network, const EnergyNetwork::Grid& grid, gsl::span<const std::pair<uint32_t, float>> supply,
+             std::vector<float>& flows, std::vector<float>& delivered);
+
+private:
+  static constexpr uint32_t none = UINT32_MAX;
+
+  void reset(size_t vertices);
+  uint32_t addArc(uint32_t from, uint32_t to, float capacity);
+
+  bool buildLevels(uint32_t source, uint32_t sink);
+  void blockingFlow(uint32_t source, uint32_t sink);
+
+  /* Arc a and its reverse a ^ 1, chained per tail vertex */
+  std::vector<uint32_t> arcTargets;
+  std::vector<uint32_t> arcNext;
+  std::vector<float> arcResiduals;
+  std::vector<uint32_t> heads;
+
+  std::vector<int32_t> levels;
+  std::vector<uint32_t> cursors;
+  std::vector<uint32_t> queue;
+  std::vector<uint32_t> path;
+
+  std::vector<uint32_t> edgeArcs;
+  std::vector<uint32_t> sinkArcs;
+};
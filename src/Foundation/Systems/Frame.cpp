@@ -0,0 +1,152 @@
+#include <Foundation/Systems/Frame.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <Foundation/Systems/Corruption.hpp>
+
+namespace {
+  /* Pixels handled per kernel call, two pixels per Philox block */
+  constexpr uint32_t chunk = 256;
+}
+
+Frame::Frame(uint32_t width, uint32_t height, uint32_t fill)
+  : width { width }
+  , height { height }
+  , pixels { std::make_shared<const std::vector<uint32_t>>(size_t(width) * height, fill) }
+{ }
+
+Frame::Frame(uint32_t width, uint32_t height, std::vector<uint32_t> pixels)
+  : width { width }
+  , height { height }
+  , pixels { std::make_shared<const std::vector<uint32_t>>(std::move(pixels)) }
+{ }
+
+Frame::Frame(const Frame& base, std::vector<Patch> patches)
+  : width { base.width }
+  , height { base.height }
+  , pixels { base.pixels }
+  , patches { std::move(patches) }
+{ }
+
+uint32_t Frame::pixel(uint32_t index) const {
+  auto it = std::lower_bound(this->patches.begin(), this->patches.end(), index, [](const Patch& p, uint32_t i) {
+    return p.index < i;
+  });
+  if (it != this->patches.end() && it->index == index) {
+    return it->pixel;
+  }
+  return (*this->pixels)[index];
+}
+
+uint32_t Frame::pack(const glm::vec3& color) {
+  auto channel = [](float c) {
+    return uint32_t(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+  };
+  return channel(color.r) << 0 | channel(color.g) << 8 | channel(color.b) << 16 | 0xFF000000u;
+}
+
+glm::vec3 Frame::unpack(uint32_t pixel) {
+  return glm::vec3 { float((pixel >> 0) & 0xFF), float((pixel >> 8) & 0xFF), float((pixel >> 16) & 0xFF) } / 255.0f;
+}
+
+FramePtr corrupt(const FramePtr& frame, float errorRate, const Philox& random, uint64_t tick, uint32_t stream) {
+  if (!frame || errorRate <= 0.0f) {
+    return frame;
+  }
+
+  /* Integer threshold, a pixel is hit when its 32-bit draw falls below it */
+  uint32_t threshold = errorRate >= 1.0f ? UINT32_MAX : uint32_t(double(errorRate) * 4294967296.0);
+  const CorruptionKernel& kernel = corruptionKernel();
+
+  const uint32_t* original = frame->pixels->data();
+  size_t n = frame->size();
+  const std::vector<Frame::Patch>& previous = frame->patches;
+  auto next = previous.begin();
+
+  /*
+   * Past a quarter of the frame patches cost more than a copy, both in
+   * memory and in lookups, so the frame is flattened into its own pixels.
+   */
+  const size_t denseAfter = n / 4;
+  size_t expected = size_t(std::min(errorRate, 1.0f) * float(n)) + previous.size();
+
+  std::vector<Frame::Patch> patches;
+  std::vector<uint32_t> dense;
+  auto flatten = [&] {
+    dense.assign(original, original + n);
+    for (const Frame::Patch& p : previous) {
+      dense[p.index] = p.pixel;
+    }
+    /* Newer than the previous patches, they include the ones carried over */
+    for (const Frame::Patch& p : patches) {
+      dense[p.index] = p.pixel;
+    }
+    patches = {};
+  };
+
+  if (expected > denseAfter) {
+    flatten();
+  }
+  else {
+    patches.reserve(expected);
+  }
+
+  uint32_t hits = 0;
+  uint32_t input[chunk];
+  uint32_t scratch[chunk];
+
+  for (size_t base = 0; base < n; base += chunk) {
+    uint32_t count = uint32_t(std::min<size_t>(chunk, n - base));
+    CorruptionChunk c { uint32_t(base / 2), stream, tick, threshold };
+
+    if (!dense.empty()) {
+      uint32_t chunkHits = kernel.run(random, c, dense.data() + base, scratch, count);
+      if (chunkHits != 0) {
+        std::copy(scratch, scratch + count, dense.begin() + base);
+        hits += chunkHits;
+      }
+      continue;
+    }
+
+    /* Chunks patched by an earlier corruption are corrupted as they look now */
+    auto first = next;
+    while (next != previous.end() && next->index < base + count) {
+      ++next;
+    }
+    const uint32_t* in = original + base;
+    if (first != next) {
+      std::copy(in, in + count, input);
+      for (auto it = first; it != next; ++it) {
+        input[it->index - base] = it->pixel;
+      }
+      in = input;
+    }
+
+    uint32_t chunkHits = kernel.run(random, c, in, scratch, count);
+    if (chunkHits == 0) {
+      patches.insert(patches.end(), first, next);
+      continue;
+    }
+
+    /* Only pixels that differ from the shared ones are stored */
+    hits += chunkHits;
+    for (uint32_t i = 0; i < count; i++) {
+      if (scratch[i] != original[base + i]) {
+        patches.push_back({ uint32_t(base + i), scratch[i] });
+      }
+    }
+
+    if (patches.size() > denseAfter) {
+      flatten();
+    }
+  }
+
+  if (hits == 0) {
+    return frame;
+  }
+  if (!dense.empty()) {
+    return std::make_shared<const Frame>(frame->width, frame->height, std::move(dense));
+  }
+  return std::make_shared<const Frame>(*frame, std::move(patches));
+}
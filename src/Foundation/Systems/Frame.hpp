@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Util/Philox.hpp>
+
+/*
+ * Image carried over video connections. Pixels are RGBA8 packed with red
+ * in the low byte, the layout of GL_RGBA/GL_UNSIGNED_BYTE and ImU32.
+ *
+ * Frames are immutable once sent and passed around as FramePtr, so every
+ * receiver of one sender shares the same allocation. A lightly corrupted
+ * frame is an overlay: it shares the pixels of the frame it came from and
+ * only stores the pixels that differ, sorted by index.
+ */
+struct Frame {
+  struct Patch {
+    uint32_t index;
+    uint32_t pixel;
+  };
+
+  Frame(uint32_t width, uint32_t height, uint32_t fill = 0);
+  Frame(uint32_t width, uint32_t height, std::vector<uint32_t> pixels);
+  Frame(const Frame& base, std::vector<Patch> patches);
+
+  uint32_t at(uint32_t x, uint32_t y) const {
+    return this->pixel(y * this->width + x);
+  }
+
+  uint32_t pixel(uint32_t index) const;
+
+  size_t size() const {
+    return this->pixels->size();
+  }
+
+  static uint32_t pack(const glm::vec3& color);
+  static glm::vec3 unpack(uint32_t pixel);
+
+  uint32_t width;
+  uint32_t height;
+  std::shared_ptr<const std::vector<uint32_t>> pixels;
+  std::vector<Patch> patches;
+};
+
+using FramePtr = std::shared_ptr<const Frame>;
+
+/*
+ * Replaces each pixel with a random colour with probability errorRate.
+ * The result shares the frame's pixels and stores only the hits, unless
+ * more than a quarter of the frame differs, then it's a plain copy. If
+ * nothing is hit the frame is returned as is. Draws are keyed by (tick, stream,
+ * pixel) so results don't depend on the thread or the order edges are
+ * visited in.
+ */
+FramePtr corrupt(const FramePtr& frame, float errorRate, const Philox& random, uint64_t tick, uint32_t stream);
@@ -0,0 +1,12 @@
+#include <Foundation/Systems/Mailbox.hpp>
+
+#include <imgui.h>
+
+void drawQueueStatistics(const Endpoint* port, const Capabilities::Queue& queue, size_t highWater, uint64_t dropped, uint64_t rejected) {
+  if (highWater == 0 && dropped == 0 && rejected == 0) {
+    return;
+  }
+
+  ImGui::BulletText("%s: high-water %zu / %u, %llu dropped, %llu rejected", port->name().c_str(), highWater, queue.capacity,
+                    (unsigned long long) dropped, (unsigned long long) rejected);
+}
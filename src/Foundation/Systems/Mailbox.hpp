@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <Foundation/Infrastructures/Infrastructure.hpp>
+#include <Util/SpscQueue.hpp>
+
+enum class SendStatus : uint8_t {
+  Sent,
+  /* The outbox is full and the port blocks, try again later */
+  Full,
+  /* The outbox is full and the message was discarded */
+  Dropped,
+  /* The port doesn't carry this kind of message */
+  Unsupported,
+};
+
+/*
+ * Messages sent from and delivered to one port. The owning component
+ * produces into the outbox and consumes the inbox, the system does the
+ * opposite, so each ring has a single producer and a single consumer.
+ *
+ * Overflow policies are applied by the system, which keeps messages the
+ * inbox has no room for in a backlog only it touches. Together backlog and
+ * inbox hold at most queue.capacity messages, except that a blocking port
+ * fed by several senders may overshoot by one message per sender.
+ *
+ * Messages in the inbox belong to the component and can't be evicted, so a
+ * DropOldest inbox only holds a quarter of the queue. The rest waits in the
+ * backlog, where the oldest messages are dropped while the component stalls.
+ */
+template <typename T>
+struct Mailbox {
+  explicit Mailbox(Capabilities::Queue queue)
+    : queue { queue }
+    , outbox { std::max<uint32_t>(queue.capacity, 1) }
+    , inbox { inboxCapacity(queue) }
+  { }
+
+  /* Component side */
+
+  SendStatus send(T&& value) {
+    if (this->outbox.push(std::move(value))) {
+      return SendStatus::Sent;
+    }
+    return this->overflow();
+  }
+
+  /* What send returns for a full outbox, lets senders check outbox.full() before building a message */
+  SendStatus overflow() {
+    if (this->queue.overflow == Capabilities::Overflow::Block) {
+      return SendStatus::Full;
+    }
+
+    /* Only the system may pop the outbox, so even DropOldest drops the new message here */
+    this->rejected.fetch_add(1, std::memory_order_relaxed);
+    return SendStatus::Dropped;
+  }
+
+  /* System side */
+
+  size_t pending() const {
+    return this->backlog.size() + this->inbox.size();
+  }
+
+  /* Messages a blocking receiver still accepts */
+  size_t room() const {
+    size_t p = this->pending();
+    return p < this->queue.capacity ? this->queue.capacity - p : 0;
+  }
+
+  void collect() {
+    if (!this->collected) {
+      this->outbox.drain([this](T& value) {
+        this->staged.push_back(std::move(value));
+      }, this->limit);
+      this->collected = true;
+    }
+  }
+
+  /* Queues value for the component, returns false if it was dropped instead */
+  bool deliver(const T& value) {
+    if (this->pending() >= this->queue.capacity) {
+      switch (this->queue.overflow) {
+        case Capabilities::Overflow::Block:
+          /* Senders were limited to the room left, only fan-in gets here */
+          break;
+
+        case Capabilities::Overflow::DropOldest:
+          /* The backlog is only empty here for single message queues, whose inbox is the whole queue */
+          if (this->backlog.empty()) {
+            this->dropped++;
+            return false;
+          }
+          this->backlog.pop_front();
+          this->dropped++;
+          break;
+
+        case Capabilities::Overflow::DropNewest:
+          this->dropped++;
+          return false;
+      }
+    }
+
+    this->backlog.push_back(value);
+    return true;
+  }
+
+  /* Moves as much of the backlog into the inbox as fits, ends the update for a receiver */
+  void flush() {
+    while (!this->backlog.empty() && this->inbox.push(std::move(this->backlog.front()))) {
+      this->backlog.pop_front();
+    }
+    this->highWater = std::max(this->highWater, this->pending());
+    this->fanIn = 0;
+  }
+
+  /* Ends the update for a sender */
+  void release() {
+    this->staged.clear();
+    this->collected = false;
+    this->limit = SIZE_MAX;
+  }
+
+  Capabilities::Queue queue;
+
+  SpscQueue<T> outbox;
+  SpscQueue<T> inbox;
+
+  /* Only touched by the system */
+  std::vector<T> staged;
+  std::deque<T> backlog;
+  bool collected = false;
+  /* Most a sender may hand over this update, and blocking senders feeding a receiver */
+  size_t limit = SIZE_MAX;
+  size_t fanIn = 0;
+
+  /* Statistics */
+  size_t highWater = 0;
+  uint64_t dropped = 0;
+  std::atomic<uint64_t> rejected { 0 };
+private:
+  static uint32_t inboxCapacity(const Capabilities::Queue& queue) {
+    uint32_t capacity = queue.overflow == Capabilities::Overflow::DropOldest ? queue.capacity / 4 : queue.capacity;
+    return std::max<uint32_t>(capacity, 1);
+  }
+};
+
+/*
+ * One update of a mailbox based system. mailbox(Endpoint*) returns the
+ * port's Mailbox<T> or nullptr. Every sender is collected once, however
+ * many edges leave it, then deliver(Connection&) moves the staged messages
+ * along each edge and receivers flush their backlogs.
+ */
+template <typename T, typename Lookup, typename Deliver>
+void exchange(const std::vector<Connection*>& edges, std::vector<Mailbox<T>*>& senders, Lookup&& mailbox, Deliver&& deliver) {
+  /* Blocking receivers split the room they have left between their senders */
+  for (Connection* edge : edges) {
+    Mailbox<T>* from = mailbox(edge->from);
+    Mailbox<T>* to = mailbox(edge->to);
+    if (from != nullptr && to != nullptr && to->queue.overflow == Capabilities::Overflow::Block) {
+      to->fanIn++;
+    }
+  }
+
+  for (Connection* edge : edges) {
+    Mailbox<T>* from = mailbox(edge->from);
+    Mailbox<T>* to = mailbox(edge->to);
+    if (from != nullptr && to != nullptr && to->queue.overflow == Capabilities::Overflow::Block) {
+      from->limit = std::min(from->limit, (to->room() + to->fanIn - 1) / to->fanIn);
+    }
+  }
+
+  for (Connection* edge : edges) {
+    Mailbox<T>* from = mailbox(edge->from);
+    if (from != nullptr && !from->collected) {
+      from->collect();
+      senders.push_back(from);
+    }
+  }
+
+  for (Connection* edge : edges) {
+    deliver(*edge);
+  }
+
+  for (Connection* edge : edges) {
+    if (Mailbox<T>* to = mailbox(edge->to)) {
+      to->flush();
+    }
+  }
+
+  for (Mailbox<T>* sender : senders) {
+    sender->release();
+  }
+  senders.clear();
+}
+
+/* Shows one port's queue in a system UI, ports that never queued anything are skipped */
+void drawQueueStatistics(const Endpoint* port, const Capabilities::Queue& queue, size_t highWater, uint64_t dropped, uint64_t rejected);
+
+template <typename T>
+void drawQueueStatistics(const Endpoint* port, const Mailbox<T>& mailbox) {
+  drawQueueStatistics(port, mailbox.queue, mailbox.highWater, mailbox.dropped, mailbox.rejected.load(std::memory_order_relaxed));
+}
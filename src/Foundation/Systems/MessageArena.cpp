@@ -0,0 +1,135 @@
+#include <Foundation/Systems/MessageArena.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+Message::Message(ArenaBlock* block, const char* text, uint32_t size)
+  : block { block }
+  , text { text }
+  , size { size }
+{
+  this->block->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+Message::Message(const Message& other)
+  : block { other.block }
+  , text { other.text }
+  , size { other.size }
+{
+  if (this->block != nullptr) {
+    this->block->references.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+Message::Message(Message&& other) noexcept
+  : block { other.block }
+  , text { other.text }
+  , size { other.size }
+{
+  other.block = nullptr;
+  other.text = nullptr;
+  other.size = 0;
+}
+
+Message& Message::operator=(const Message& other) {
+  if (this != &other) {
+    Message copy { other };
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+Message& Message::operator=(Message&& other) noexcept {
+  if (this != &other) {
+    this->release();
+
+    this->block = other.block;
+    this->text = other.text;
+    this->size = other.size;
+
+    other.block = nullptr;
+    other.text = nullptr;
+    other.size = 0;
+  }
+  return *this;
+}
+
+Message::~Message() {
+  this->release();
+}
+
+void Message::release() {
+  if (this->block != nullptr && this->block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    this->block->arena->recycle(this->block);
+  }
+  this->block = nullptr;
+}
+
+MessageArena::~MessageArena() {
+  for (ArenaBlock* block : this->freeBlocks) {
+    block->~ArenaBlock();
+    ::operator delete(block);
+  }
+}
+
+ArenaBlock* MessageArena::acquire(uint32_t size) {
+  if (size <= blockSize) {
+    std::lock_guard lock { this->mutex };
+
+    if (!this->freeBlocks.empty()) {
+      ArenaBlock* block = this->freeBlocks.back();
+      this->freeBlocks.pop_back();
+
+      block->references.store(1, std::memory_order_relaxed);
+      block->used = 0;
+      return block;
+    }
+  }
+
+  /* Oversized messages get a block of their own, which isn't pooled */
+  uint32_t capacity = std::max(size, blockSize);
+  void* memory = ::operator new(sizeof(ArenaBlock) + capacity);
+
+  this->allocatedBlocks.fetch_add(1, std::memory_order_relaxed);
+  return new (memory) ArenaBlock { this, capacity };
+}
+
+void MessageArena::recycle(ArenaBlock* block) {
+  if (block->capacity == blockSize) {
+    std::lock_guard lock { this->mutex };
+    this->freeBlocks.push_back(block);
+    return;
+  }
+
+  this->allocatedBlocks.fetch_sub(1, std::memory_order_relaxed);
+  block->~ArenaBlock();
+  ::operator delete(block);
+}
+
+ArenaWriter::~ArenaWriter() {
+  this->retire();
+}
+
+Message ArenaWriter::write(std::string_view text) {
+  uint32_t size = text.size();
+
+  if (this->current == nullptr || this->current->capacity - this->current->used < size) {
+    this->retire();
+    this->current = this->arena.acquire(size);
+  }
+
+  char* destination = this->current->data() + this->current->used;
+  std::memcpy(destination, text.data(), size);
+  this->current->used += size;
+
+  return Message { this->current, destination, size };
+}
+
+void ArenaWriter::retire() {
+  /* Drops the writer's reference, the block is recycled with its last message */
+  if (this->current != nullptr && this->current->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    this->arena.recycle(this->current);
+  }
+  this->current = nullptr;
+}
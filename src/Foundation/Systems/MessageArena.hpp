@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+class MessageArena;
+
+/* Chunk of message text, its bytes follow the header */
+struct ArenaBlock {
+  ArenaBlock(MessageArena* arena, uint32_t capacity)
+    : arena { arena }
+    , capacity { capacity }
+  { }
+
+  char* data() {
+    return reinterpret_cast<char*>(this + 1);
+  }
+
+  MessageArena* arena;
+  /* One per message, plus one while a writer is filling the block */
+  std::atomic<uint32_t> references { 1 };
+  uint32_t used = 0;
+  const uint32_t capacity;
+};
+
+/* Text of one message inside an ArenaBlock, keeps the block alive */
+class Message {
+public:
+  Message() = default;
+  Message(ArenaBlock* block, const char* text, uint32_t size);
+
+  Message(const Message& other);
+  Message(Message&& other) noexcept;
+  Message& operator=(const Message& other);
+  Message& operator=(Message&& other) noexcept;
+  ~Message();
+
+  std::string_view view() const {
+    return { text, size };
+  }
+
+private:
+  void release();
+
+  ArenaBlock* block = nullptr;
+  const char* text = nullptr;
+  uint32_t size = 0;
+};
+
+/*
+ * Pool of blocks message text is bump-allocated from. Blocks return to the
+ * pool once every message in them has been released, so steady traffic
+ * reuses the same few blocks instead of allocating a string per message.
+ */
+class MessageArena {
+public:
+  static constexpr uint32_t blockSize = 16 * 1024;
+
+  MessageArena() = default;
+  MessageArena(const MessageArena&) = delete;
+  ~MessageArena();
+
+  /* Returns a block with room for at least size bytes */
+  ArenaBlock* acquire(uint32_t size);
+  void recycle(ArenaBlock* block);
+
+  size_t allocated() const {
+    return this->allocatedBlocks.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::mutex mutex;
+  std::vector<ArenaBlock*> freeBlocks;
+  std::atomic<size_t> allocatedBlocks { 0 };
+};
+
+/* Writes the messages of one sender into its current block, only used by the sending thread */
+class ArenaWriter {
+public:
+  explicit ArenaWriter(MessageArena& arena)
+    : arena { arena }
+  { }
+
+  ArenaWriter(const ArenaWriter&) = delete;
+  ~ArenaWriter();
+
+  Message write(std::string_view text);
+
+private:
+  void retire();
+
+  MessageArena& arena;
+  ArenaBlock* current = nullptr;
+};
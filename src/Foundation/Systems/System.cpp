@@ -4,14 +4,58 @@
 
 #include <imgui.h>
 
+System::~System() {
+  this->universe->connections.unsubscribe(this);
+}
+
 void System::update() {
-  for (auto& connection : this->universe->connections) {
-    if (this->filter(connection)) {
-      this->swap(connection);
-    }
+  for (Connection* edge : this->edges) {
+    this->swap(*edge);
+  }
+}
+
+void System::connected(Connection& edge) {
+  if (this->filter(edge)) {
+    this->addEdge(&edge);
+  }
+}
+
+void System::disconnected(Connection& edge) {
+  this->removeEdge(&edge);
+}
+
+void System::changed(Connection& edge) {
+  if (this->filter(edge)) {
+    this->addEdge(&edge);
+  }
+  else {
+    this->removeEdge(&edge);
+  }
+}
+
+void System::addEdge(Connection* edge) {
+  if (this->edgeIndices.count(edge) == 0) {
+    this->edgeIndices.emplace(edge, this->edges.size());
+    this->edges.push_back(edge);
   }
 }
 
+void System::removeEdge(Connection* edge) {
+  auto it = this->edgeIndices.find(edge);
+  if (it == this->edgeIndices.end()) {
+    return;
+  }
+
+  /* Swap with the last edge and pop */
+  size_t ix = it->second;
+  Connection* last = this->edges.back();
+  this->edges[ix] = last;
+  this->edgeIndices[last] = ix;
+
+  this->edges.pop_back();
+  this->edgeIndices.erase(edge);
+}
+
 void System::timePassed(std::chrono::system_clock::duration d) {
   deltaCounter += d;
   const auto oneTick = std::chrono::microseconds(1000000 / ups);
@@ -21,6 +65,7 @@ void System::timePassed(std::chrono::system_clock::duration d) {
     if (this->active) {
       upsCounter++;
       update();
+      ticks++;
     }
   }
 
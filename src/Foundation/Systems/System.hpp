@@ -3,23 +3,35 @@
 #include <string>
 #include <string_view>
 #include <chrono>
+#include <unordered_map>
+#include <vector>
 
 #include <Foundation/Infrastructures/Infrastructure.hpp>
+#include <Foundation/Infrastructures/ConnectionGraph.hpp>
 
 class Universe;
 
-struct System {
+struct System : public ConnectionListener {
   System(Universe* u, std::string_view name, uint32_t ups = 20)
     : universe { u }
     , name { name }
     , ups { ups }
   { }
 
-  virtual ~System() = default;
+  /* Subscribed to the connection graph by Universe::add */
+  ~System() override;
 
   virtual bool filter(const Connection& edge) const = 0;
   virtual void swap(Connection& edge) = 0;
 
+  void connected(Connection& edge) override;
+  void disconnected(Connection& edge) override;
+  void changed(Connection& edge) override;
+
+  /* Called for every port of every component, for per-port state */
+  virtual void attach(Endpoint* port) { }
+  virtual void detach(Endpoint* port) { }
+
   void timePassed(std::chrono::system_clock::duration d);
   virtual void update();
 
@@ -32,7 +44,19 @@ struct System {
 
   uint32_t ups;
   float actualUps = 0.0f;
+  /* Number of updates run so far, independent of wall-clock rate */
+  uint64_t ticks = 0;
   std::chrono::system_clock::duration deltaCounter { 0 };
   std::chrono::system_clock::duration upsTimeCounter { 0 };
   uint32_t upsCounter = 0;
+
+protected:
+  /* Connections passing filter(), kept up to date by the connection graph */
+  std::vector<Connection*> edges;
+
+private:
+  void addEdge(Connection* edge);
+  void removeEdge(Connection* edge);
+
+  std::unordered_map<Connection*, size_t> edgeIndices;
 };
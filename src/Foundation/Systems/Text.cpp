@@ -1,24 +1,103 @@
 #include <Foundation/Systems/Text.hpp>
 
+#include <imgui.h>
+
 bool TextSystem::filter(const Connection& edge) const {
   return edge.capabilities.text.enabled;
 }
 
+void TextSystem::update() {
+  exchange(this->edges, this->senders, [](Endpoint* p) -> Mailbox<Message>* {
+    return p->textMailbox;
+  }, [this](Connection& edge) {
+    this->swap(edge);
+  });
+}
+
 void TextSystem::swap(Connection& edge) {
-  std::swap(sendBuffers[edge.from], recvBuffers[edge.to]);
+  TextMailbox* from = edge.from->textMailbox;
+  TextMailbox* to = edge.to->textMailbox;
+
+  if (from == nullptr || to == nullptr) {
+    return;
+  }
+
+  /* Receivers share the sender's arena block, delivering only bumps its reference count */
+  Link& link = this->links[&edge];
+  for (const Message& m : from->staged) {
+    if (to->deliver(m)) {
+      link.delivered++;
+    }
+    else {
+      link.dropped++;
+    }
+  }
+}
+
+void TextSystem::disconnected(Connection& edge) {
+  System::disconnected(edge);
+  this->links.erase(&edge);
+}
+
+void TextSystem::attach(Endpoint* port) {
+  if (port->capabilities.text.enabled) {
+    auto& mailbox = this->mailboxes[port];
+    mailbox = std::make_unique<TextMailbox>(port->capabilities.text.queue, this->arena);
+    port->textMailbox = mailbox.get();
+  }
+}
+
+void TextSystem::detach(Endpoint* port) {
+  port->textMailbox = nullptr;
+  this->mailboxes.erase(port);
 }
 
-void TextSystem::send(Endpoint* port, const std::string& m) {
-  sendBuffers[port].messages.push(m);
+SendStatus TextSystem::send(Endpoint* port, std::string_view m) {
+  if (port->textMailbox == nullptr) {
+    return SendStatus::Unsupported;
+  }
+
+  /* Nothing is copied into the arena while the outbox has no room, blocking senders retry cheaply */
+  TextMailbox* mailbox = port->textMailbox;
+  if (mailbox->outbox.full()) {
+    return mailbox->overflow();
+  }
+  return mailbox->send(mailbox->writer.write(m));
 }
 
 std::optional<std::string> TextSystem::receive(Endpoint* port) {
-  if (recvBuffers[port].messages.empty()) {
+  if (port->textMailbox == nullptr) {
     return std::nullopt;
   }
-  else {
-    std::string res = recvBuffers[port].messages.front();
-    recvBuffers[port].messages.pop();
-    return res;
+
+  if (auto m = port->textMailbox->inbox.pop()) {
+    return std::string { m->view() };
+  }
+  return std::nullopt;
+}
+
+const TextSystem::Link* TextSystem::link(const Connection* edge) const {
+  auto it = this->links.find(edge);
+  return it != this->links.end() ? &it->second : nullptr;
+}
+
+void TextSystem::UI() {
+  System::UI();
+  ImGui::Text("Arena blocks: %zu", this->arena.allocated());
+
+  if (ImGui::TreeNode("Ports")) {
+    for (auto& pair : this->mailboxes) {
+      drawQueueStatistics(pair.first, *pair.second);
+    }
+    ImGui::TreePop();
+  }
+
+  if (ImGui::TreeNode("Links")) {
+    for (auto& pair : this->links) {
+      const Connection* c = pair.first;
+      ImGui::BulletText("%s -> %s: %llu delivered, %llu dropped", c->from->name().c_str(), c->to->name().c_str(),
+                        (unsigned long long) pair.second.delivered, (unsigned long long) pair.second.dropped);
+    }
+    ImGui::TreePop();
   }
 }
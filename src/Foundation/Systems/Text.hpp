@@ -1,15 +1,32 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <optional>
-#include <queue>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <Foundation/Systems/System.hpp>
+#include <Foundation/Systems/Mailbox.hpp>
+#include <Foundation/Systems/MessageArena.hpp>
+
+struct TextMailbox : public Mailbox<Message> {
+  TextMailbox(Capabilities::Queue queue, MessageArena& arena)
+    : Mailbox { queue }
+    , writer { arena }
+  { }
+
+  /* Used by the sending component only, like the outbox */
+  ArenaWriter writer;
+};
 
 struct TextSystem : public System {
-  struct Buffer {
-    std::queue<std::string> messages;
+  /* Per-connection message counters */
+  struct Link {
+    uint64_t delivered = 0;
+    uint64_t dropped = 0;
   };
 
   explicit TextSystem(Universe* u)
@@ -19,9 +36,50 @@ struct TextSystem : public System {
   bool filter(const Connection& edge) const override;
   void swap(Connection& edge) override;
 
-  void send(Endpoint* port, const std::string& m);
+  void disconnected(Connection& edge) override;
+
+  void attach(Endpoint* port) override;
+  void detach(Endpoint* port) override;
+
+  void update() override;
+  void UI() override;
+
+  /* Copies m into the sender's arena block, the caller's buffer can be reused right away */
+  SendStatus send(Endpoint* port, std::string_view m);
   std::optional<std::string> receive(Endpoint* port);
 
-  std::unordered_map<Endpoint*, Buffer> sendBuffers;
-  std::unordered_map<Endpoint*, Buffer> recvBuffers;
+  /*
+   * Calls visit(std::string_view) on every pending message in order, returns
+   * how many there were. The views are only valid during the call.
+   */
+  template <typename F>
+  size_t drain(Endpoint* port, F&& visit) {
+    if (port->textMailbox == nullptr) {
+      return 0;
+    }
+    return port->textMailbox->inbox.drain([&visit](Message& m) {
+      visit(m.view());
+      m = Message {};
+    });
+  }
+
+  /* Appends a copy of every pending message to out */
+  template <typename Container>
+  size_t receiveAll(Endpoint* port, Container& out) {
+    return this->drain(port, [&out](std::string_view m) {
+      out.emplace_back(m);
+    });
+  }
+
+  const Link* link(const Connection* edge) const;
+
+private:
+  /* Declared before the mailboxes, which release their messages into it */
+  MessageArena arena;
+
+  std::unordered_map<Endpoint*, std::unique_ptr<TextMailbox>> mailboxes;
+  std::unordered_map<const Connection*, Link> links;
+
+  /* Mailboxes collected during the current update */
+  std::vector<Mailbox<Message>*> senders;
 };
@@ -1,26 +1,57 @@
 #include <Foundation/Systems/Video.hpp>
 
-#include <Util/Random.hpp>
+#include <Foundation/Universe.hpp>
+
+VideoSystem::VideoSystem(Universe* u)
+  : System { u, "Video", 60 }
+  , random { u->seed }
+{ }
 
 bool VideoSystem::filter(const Connection& edge) const {
   return edge.capabilities.video.enabled;
 }
 
 void VideoSystem::swap(Connection& edge) {
-  if (randomFloat() < edge.capabilities.video.errorRate) {
-    buffers[edge.to] = randomColor();
+  if (edge.from->videoBuffer == nullptr || edge.to->videoBuffer == nullptr) {
+    return;
+  }
+
+  /* Receivers share the sender's frame unless errors force a private copy */
+  const FramePtr& frame = edge.from->videoBuffer->outgoing.latest();
+  edge.to->videoBuffer->incoming.publish(corrupt(frame, edge.capabilities.video.errorRate, this->random, this->ticks, uint32_t(edge.id)));
+}
+
+void VideoSystem::disconnected(Connection& edge) {
+  /* Blank the receiver, other incoming edges refill it on the next update */
+  if (edge.to->videoBuffer != nullptr) {
+    edge.to->videoBuffer->incoming.publish(nullptr);
   }
-  else {
-    buffers[edge.to] = buffers[edge.from];
+
+  System::disconnected(edge);
+}
+
+void VideoSystem::attach(Endpoint* port) {
+  if (port->capabilities.video.enabled) {
+    auto& buffer = this->buffers[port];
+    buffer = std::make_unique<VideoBuffer>();
+    port->videoBuffer = buffer.get();
   }
 }
 
-void VideoSystem::send(Endpoint* port, const glm::vec3& v) {
-  buffers[port] = v;
+void VideoSystem::detach(Endpoint* port) {
+  port->videoBuffer = nullptr;
+  this->buffers.erase(port);
+}
+
+void VideoSystem::send(Endpoint* port, FramePtr frame) {
+  if (port->videoBuffer != nullptr) {
+    port->videoBuffer->outgoing.publish(std::move(frame));
+  }
 }
 
-std::optional<glm::vec3> VideoSystem::receive(Endpoint* port) {
-  std::optional<glm::vec3> res = buffers[port];
-  buffers[port] = std::nullopt;
-  return res;
+FramePtr VideoSystem::receive(Endpoint* port) {
+  if (port->videoBuffer == nullptr) {
+    return nullptr;
+  }
+  return port->videoBuffer->incoming.latest();
 }
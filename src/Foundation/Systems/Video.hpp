@@ -1,24 +1,42 @@
 #pragma once
 
-#include <optional>
+#include <memory>
 #include <unordered_map>
 
-#include <glm/glm.hpp>
-
 #include <Foundation/Systems/System.hpp>
+#include <Foundation/Systems/Frame.hpp>
+#include <Util/Philox.hpp>
+#include <Util/TripleBuffer.hpp>
+
+/*
+ * Frames of one video port. The owning component publishes into outgoing
+ * and reads incoming, VideoSystem does the opposite, so each direction has
+ * exactly one writer and one reader.
+ */
+struct VideoBuffer {
+  TripleBuffer<FramePtr> outgoing;
+  TripleBuffer<FramePtr> incoming;
+};
 
 class VideoSystem : public System {
-  using Buffer = std::optional<glm::vec3>;
 public:
-  explicit VideoSystem(Universe* u)
-    : System { u, "Video", 60 }
-  { }
+  explicit VideoSystem(Universe* u);
 
   bool filter(const Connection& edge) const override;
   void swap(Connection& edge) override;
 
-  void send(Endpoint* port, const glm::vec3& v);
-  std::optional<glm::vec3> receive(Endpoint* port);
+  void disconnected(Connection& edge) override;
+
+  void attach(Endpoint* port) override;
+  void detach(Endpoint* port) override;
+
+  void send(Endpoint* port, FramePtr frame);
+  /* Latest frame arriving at port, stays until a newer one or a disconnect replaces it */
+  FramePtr receive(Endpoint* port);
+
+private:
+  /* Error injection is keyed by (universe seed, tick, edge id, pixel) */
+  Philox random;
 
-  std::unordered_map<Endpoint*, Buffer> buffers;
+  std::unordered_map<Endpoint*, std::unique_ptr<VideoBuffer>> buffers;
 };
@@ -0,0 +1,129 @@
+#include <Foundation/ThreadPool.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+ThreadPool::ThreadPool(size_t threads) {
+  threads = std::max<size_t>(threads, 1);
+
+  this->workers.reserve(threads);
+  for (size_t i = 0; i < threads; i++) {
+    this->workers.emplace_back(&ThreadPool::work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock { this->mutex };
+    this->stopping = true;
+  }
+  this->taskAvailable.notify_all();
+
+  for (auto& t : this->workers) {
+    t.join();
+  }
+}
+
+void ThreadPool::submit(Job job) {
+  {
+    std::lock_guard lock { this->mutex };
+    this->tasks.push(Task { std::move(job), Clock::now() });
+    this->pending++;
+  }
+  this->taskAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+  std::unique_lock lock { this->mutex };
+  this->allDone.wait(lock, [this] { return this->pending == 0; });
+}
+
+void ThreadPool::parallelFor(size_t n, const std::function<void(size_t)>& body) {
+  if (n == 0) {
+    return;
+  }
+  if (n == 1) {
+    body(0);
+    return;
+  }
+
+  /* Shared with helper jobs, which may still be queued after this returns */
+  struct Batch {
+    const std::function<void(size_t)>* body;
+    size_t size;
+    std::atomic<size_t> next { 0 };
+    std::atomic<size_t> done { 0 };
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+
+  auto batch = std::make_shared<Batch>();
+  batch->body = &body;
+  batch->size = n;
+
+  /* Only touches body after successfully claiming an index */
+  auto run = [batch] {
+    for (size_t i = batch->next++; i < batch->size; i = batch->next++) {
+      (*batch->body)(i);
+
+      if (++batch->done == batch->size) {
+        std::lock_guard lock { batch->mutex };
+        batch->finished.notify_all();
+      }
+    }
+  };
+
+  size_t helpers = std::min(n - 1, this->workers.size());
+  for (size_t i = 0; i < helpers; i++) {
+    this->submit(run);
+  }
+
+  run();
+
+  std::unique_lock lock { batch->mutex };
+  batch->finished.wait(lock, [&batch] { return batch->done == batch->size; });
+}
+
+ThreadPool::Statistics ThreadPool::statistics() const {
+  std::lock_guard lock { this->mutex };
+  return this->stats;
+}
+
+void ThreadPool::resetStatistics() {
+  std::lock_guard lock { this->mutex };
+  this->stats = Statistics {};
+}
+
+void ThreadPool::work() {
+  std::unique_lock lock { this->mutex };
+
+  while (true) {
+    this->taskAvailable.wait(lock, [this] { return this->stopping || !this->tasks.empty(); });
+
+    if (this->tasks.empty()) {
+      return;
+    }
+
+    Task task = std::move(this->tasks.front());
+    this->tasks.pop();
+
+    auto started = Clock::now();
+    lock.unlock();
+
+    task.job();
+
+    auto finished = Clock::now();
+    lock.lock();
+
+    /* Update statistics */
+    auto waited = started - task.submitted;
+    this->stats.jobs++;
+    this->stats.queueWait += waited;
+    this->stats.runTime += finished - started;
+    this->stats.maxQueueWait = std::max(this->stats.maxQueueWait, waited);
+
+    if (--this->pending == 0) {
+      this->allDone.notify_all();
+    }
+  }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Job = std::function<void()>;
+
+  struct Statistics {
+    uint64_t jobs = 0;
+    Clock::duration queueWait { 0 };
+    Clock::duration runTime { 0 };
+    Clock::duration maxQueueWait { 0 };
+  };
+
+  explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+  ThreadPool(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  void submit(Job job);
+
+  /* Blocks until every job submitted so far has finished */
+  void wait();
+
+  /*
+   * Runs body(i) for every i in [0, n) on the workers and the calling
+   * thread, returning once all of them have finished. The caller keeps
+   * claiming indices itself, so this is safe to call from inside a job.
+   */
+  void parallelFor(size_t n, const std::function<void(size_t)>& body);
+
+  size_t size() const {
+    return this->workers.size();
+  }
+
+  Statistics statistics() const;
+  void resetStatistics();
+
+private:
+  struct Task {
+    Job job;
+    Clock::time_point submitted;
+  };
+
+  void work();
+
+  std::vector<std::thread> workers;
+  std::queue<Task> tasks;
+
+  mutable std::mutex mutex;
+  std::condition_variable taskAvailable;
+  std::condition_variable allDone;
+
+  size_t pending = 0;
+  bool stopping = false;
+
+  Statistics stats;
+};
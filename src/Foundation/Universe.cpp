@@ -1,10 +1,17 @@
 #include <Foundation/Universe.hpp>
 
+#include <algorithm>
 #include <stdexcept>
-#include <thread>
 
 #include <Foundation/Infrastructures/Manual.hpp>
 
+Universe::~Universe() {
+  /* Components unregister their connections on destruction, listeners unsubscribe while the graph is still alive */
+  this->components.clear();
+  this->infrastructures.clear();
+  this->systems.clear();
+}
+
 void Universe::tick() {
   /* Compute delta time */
   if (this->oldTime == std::chrono::system_clock::time_point::min()) {
@@ -14,19 +21,20 @@ void Universe::tick() {
   std::chrono::system_clock::duration delta = newTime - oldTime;
   oldTime = newTime;
 
+  this->tick(delta);
+}
+
+void Universe::tick(std::chrono::system_clock::duration delta) {
   /* Update components */
   for (auto& component : this->components) {
     component->update();
   }
 
   /* Update systems */
-  std::vector<std::thread> systemThreads;
   for (auto& system : this->systems) {
-    systemThreads.emplace_back(&System::timePassed, system.get(), delta);
-  }
-  for (auto& t : systemThreads) {
-    t.join();
+    this->pool.submit([s = system.get(), delta] { s->timePassed(delta); });
   }
+  this->pool.wait();
 
   /* Update infrastructures */
   for (auto& infrastructure : this->infrastructures) {
@@ -38,19 +46,30 @@ void Universe::render() {
   for (auto& component : this->components) {
     component->render();
   }
+
+  for (auto& infrastructure : this->infrastructures) {
+    infrastructure->render();
+  }
+}
+
+void Universe::remove(Component* component) {
+  this->unindex(component);
+
+  auto pred = [component](const std::unique_ptr<Component>& c) {
+    return c.get() == component;
+  };
+
+  this->components.erase(std::remove_if(this->components.begin(), this->components.end(), pred), this->components.end());
 }
 
 Endpoint* Universe::lookupPort(const std::string& componentName, const std::string& portName) {
-  for (auto& c : this->components) {
-    if (c->name() == componentName) {
-      for (auto& pair : c->ports) {
-        auto& name = pair.first;
-        auto& port = pair.second;
-
-        if ((portName.empty() && name == c->defaultPort()) || name == portName) {
-          return port.get();
-        }
-      }
+  auto component = this->componentsByName.find(componentName);
+
+  if (component != this->componentsByName.end()) {
+    auto port = this->portsByName.find({ component->second, portName });
+
+    if (port != this->portsByName.end()) {
+      return port->second;
     }
   }
 
@@ -58,3 +77,66 @@ Endpoint* Universe::lookupPort(const std::string& componentName, const std::stri
       fmt::format("Component '{}' doesn't have port '{}'", componentName, portName)
   };
 }
+
+void Universe::index(Component* component) {
+  this->componentsByName.emplace(component->name(), component);
+
+  for (auto& pair : component->ports) {
+    this->portsByName.emplace(std::make_pair(component, pair.first), pair.second.get());
+  }
+
+  if (component->ports.count(component->defaultPort()) != 0) {
+    this->portsByName.emplace(std::make_pair(component, std::string {}), component->ports.at(component->defaultPort()).get());
+  }
+}
+
+void Universe::unindex(Component* component) {
+  for (auto& pair : component->ports) {
+    this->portsByName.erase({ component, pair.first });
+  }
+  this->portsByName.erase({ component, std::string {} });
+
+  std::string name = component->name();
+  auto it = this->componentsByName.find(name);
+
+  if (it != this->componentsByName.end() && it->second == component) {
+    this->componentsByName.erase(it);
+
+    /* Fall back to the next component sharing the name, if any */
+    for (auto& c : this->components) {
+      if (c.get() != component && c->name() == name) {
+        this->componentsByName.emplace(name, c.get());
+        break;
+      }
+    }
+  }
+}
+
+void Universe::announce(ConnectionListener* listener) {
+  for (auto& component : this->components) {
+    for (auto& pair : component->ports) {
+      listener->moved(*pair.second);
+    }
+  }
+}
+
+void Universe::attach(System* system) {
+  for (auto& component : this->components) {
+    for (auto& pair : component->ports) {
+      system->attach(pair.second.get());
+    }
+  }
+}
+
+void Universe::attach(Component* component) {
+  for (auto& system : this->systems) {
+    for (auto& pair : component->ports) {
+      system->attach(pair.second.get());
+    }
+  }
+
+  /* New ports are announced like moved ones, infrastructures pick them up from there */
+  for (auto& pair : component->ports) {
+    this->connections.moved(pair.second.get());
+  }
+}
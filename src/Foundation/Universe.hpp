@@ -2,36 +2,30 @@
 
 #include <vector>
 #include <chrono>
+#include <string>
+#include <unordered_map>
 
 #include <fmt/format.h>
 
 #include <Foundation/Infrastructures/Infrastructure.hpp>
+#include <Foundation/Infrastructures/ConnectionGraph.hpp>
 #include <Foundation/Components/Component.hpp>
 #include <Foundation/Systems/System.hpp>
+#include <Foundation/ThreadPool.hpp>
+#include <Util/Hash.hpp>
+#include <Util/TypeIndex.hpp>
 
 struct Universe {
+  ~Universe();
+
   template <typename T>
   T& system() {
-    for (auto& s : systems) {
-      if (auto t = dynamic_cast<T*>(s.get())) {
-        return *t;
-      }
-    }
-    throw std::runtime_error {
-        fmt::format("Universe doesn't own system of type '{}'", typeid(T).name())
-    };
+    return lookup<T>(this->systemsByType, this->systems, "system");
   }
 
   template <typename T>
   T& infrastructure() {
-    for (auto& i : infrastructures) {
-      if (auto t = dynamic_cast<T*>(i.get())) {
-        return *t;
-      }
-    }
-    throw std::runtime_error {
-        fmt::format("Universe doesn't own infrastructure of type '{}'", typeid(T).name())
-    };
+    return lookup<T>(this->infrastructuresByType, this->infrastructures, "infrastructure");
   }
 
   template <typename T, typename... Args>
@@ -40,12 +34,22 @@ struct Universe {
 
     if constexpr (std::is_base_of_v<Infrastructure, T>) {
       this->infrastructures.emplace_back(ptr);
+      registerType<Infrastructure>(this->infrastructuresByType, TypeIndex<Infrastructure>::of<T>(), ptr);
+      if constexpr (std::is_base_of_v<ConnectionListener, T>) {
+        this->connections.subscribe(ptr);
+        this->announce(ptr);
+      }
     }
     else if constexpr (std::is_base_of_v<System, T>) {
       this->systems.emplace_back(ptr);
+      registerType<System>(this->systemsByType, TypeIndex<System>::of<T>(), ptr);
+      this->connections.subscribe(ptr);
+      this->attach(ptr);
     }
     else if constexpr (std::is_base_of_v<Component, T>) {
       this->components.emplace_back(ptr);
+      this->index(ptr);
+      this->attach(ptr);
     }
     else {
       throw std::domain_error { "Universe doesn't support adding this type" };
@@ -54,7 +58,10 @@ struct Universe {
     return ptr;
   }
 
+  void remove(Component* component);
+
   void tick();
+  void tick(std::chrono::system_clock::duration delta);
   void render();
 
   Endpoint* lookupPort(const std::string& component, const std::string& port);
@@ -63,8 +70,63 @@ struct Universe {
   std::vector<std::unique_ptr<Component>> components;
   std::vector<std::unique_ptr<System>> systems;
 
-  std::vector<Connection> connections;
+  ConnectionGraph connections;
+
+  /* Keys every counter-based random stream, same seed and edits reproduce a run */
+  uint64_t seed = 0x5eed;
+
+  /* Runs system updates, outlives a single tick so no threads are spawned per frame */
+  ThreadPool pool;
 
 private:
+  template <typename T, typename Base>
+  static T& lookup(const std::vector<Base*>& byType, const std::vector<std::unique_ptr<Base>>& owned, const char* kind) {
+    size_t id = TypeIndex<Base>::template of<T>();
+
+    if (id < byType.size() && byType[id] != nullptr) {
+      return *static_cast<T*>(byType[id]);
+    }
+
+    /* Slow path for lookups through a base class of the registered type */
+    for (auto& o : owned) {
+      if (auto t = dynamic_cast<T*>(o.get())) {
+        return *t;
+      }
+    }
+
+    throw std::runtime_error {
+        fmt::format("Universe doesn't own {} of type '{}'", kind, typeid(T).name())
+    };
+  }
+
+  template <typename Base>
+  static void registerType(std::vector<Base*>& byType, size_t id, Base* ptr) {
+    if (id >= byType.size()) {
+      byType.resize(id + 1, nullptr);
+    }
+    if (byType[id] == nullptr) {
+      byType[id] = ptr;
+    }
+  }
+
+  /* Flat registries indexed by TypeIndex, filled in add() */
+  std::vector<Infrastructure*> infrastructuresByType;
+  std::vector<System*> systemsByType;
+
+  void index(Component* component);
+  void unindex(Component* component);
+
+  /* Hands ports to systems, they're detached again by ~Component */
+  void attach(System* system);
+  void attach(Component* component);
+
+  /* Publishes every existing port as moved to a listener added after the components */
+  void announce(ConnectionListener* listener);
+
+  /* Component name -> first component added under that name */
+  std::unordered_map<std::string, Component*> componentsByName;
+  /* (component, port name) -> port, the default port is also stored under "" */
+  std::unordered_map<std::pair<Component*, std::string>, Endpoint*, PairHash> portsByName;
+
   std::chrono::system_clock::time_point oldTime = std::chrono::system_clock::time_point::min();
 };
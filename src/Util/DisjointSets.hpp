@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/* Disjoint sets with path halving and union by size */
+struct DisjointSets {
+  DisjointSets() = default;
+
+  explicit DisjointSets(size_t n) {
+    this->reset(n);
+  }
+
+  /* n singleton sets */
+  void reset(size_t n) {
+    this->parents.resize(n);
+    this->sizes.assign(n, 1);
+    for (size_t i = 0; i < n; i++) {
+      this->parents[i] = i;
+    }
+  }
+
+  /* Appends a singleton set and returns its element */
+  uint32_t add() {
+    uint32_t v = this->parents.size();
+    this->parents.push_back(v);
+    this->sizes.push_back(1);
+    return v;
+  }
+
+  uint32_t find(uint32_t v) {
+    while (this->parents[v] != v) {
+      this->parents[v] = this->parents[this->parents[v]];
+      v = this->parents[v];
+    }
+    return v;
+  }
+
+  /* Returns the root of the joined set */
+  uint32_t unite(uint32_t a, uint32_t b) {
+    a = this->find(a);
+    b = this->find(b);
+    if (a == b) {
+      return a;
+    }
+    if (this->sizes[a] < this->sizes[b]) {
+      std::swap(a, b);
+    }
+    this->parents[b] = a;
+    this->sizes[a] += this->sizes[b];
+    return a;
+  }
+
+  size_t size() const {
+    return this->parents.size();
+  }
+
+  std::vector<uint32_t> parents;
+  std::vector<uint32_t> sizes;
+};
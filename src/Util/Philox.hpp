@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/*
+ * Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random
+ * Numbers: As Easy as 1, 2, 3"). Every 128-bit counter maps to four
+ * independent 32-bit words under a 64-bit key, so a draw depends only on
+ * what it's keyed by and never on which thread asks or in what order.
+ */
+struct Philox {
+  using Counter = std::array<uint32_t, 4>;
+  using Block = std::array<uint32_t, 4>;
+
+  explicit Philox(uint64_t seed)
+    : key { uint32_t(seed), uint32_t(seed >> 32) }
+  { }
+
+  /* Counter made of two 64-bit words, e.g. (tick, stream) */
+  static Counter counter(uint64_t hi, uint64_t lo) {
+    return { uint32_t(lo), uint32_t(lo >> 32), uint32_t(hi), uint32_t(hi >> 32) };
+  }
+
+  Block operator()(Counter c) const {
+    uint32_t k0 = this->key[0];
+    uint32_t k1 = this->key[1];
+
+    for (int round = 0; round < rounds; round++) {
+      c = step(c, k0, k1);
+      k0 += W0;
+      k1 += W1;
+    }
+
+    return c;
+  }
+
+  /* Uniform float in [0, 1) from the top 24 bits */
+  static float toFloat(uint32_t x) {
+    return float(x >> 8) * (1.0f / 16777216.0f);
+  }
+
+  /* Round multipliers and key increments, public for hand-vectorized callers */
+  static constexpr uint32_t M0 = 0xD2511F53;
+  static constexpr uint32_t M1 = 0xCD9E8D57;
+  static constexpr uint32_t W0 = 0x9E3779B9;
+  static constexpr uint32_t W1 = 0xBB67AE85;
+  static constexpr int rounds = 10;
+
+  std::array<uint32_t, 2> key;
+
+private:
+  static Counter step(const Counter& c, uint32_t k0, uint32_t k1) {
+    uint64_t p0 = uint64_t(M0) * c[0];
+    uint64_t p1 = uint64_t(M1) * c[2];
+    return {
+        uint32_t(p1 >> 32) ^ c[1] ^ k0,
+        uint32_t(p1),
+        uint32_t(p0 >> 32) ^ c[3] ^ k1,
+        uint32_t(p0),
+    };
+  }
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/* Reference to an object in a Pool, stale once the object is erased */
+template <typename T>
+struct Handle {
+  uint32_t index = UINT32_MAX;
+  uint32_t generation = 0;
+
+  explicit operator bool() const {
+    return this->index != UINT32_MAX;
+  }
+
+  bool operator==(const Handle& other) const {
+    return this->index == other.index && this->generation == other.generation;
+  }
+
+  bool operator!=(const Handle& other) const {
+    return !(*this == other);
+  }
+};
+
+/*
+ * Slot allocator addressed by generational handles. Slots live in fixed
+ * chunks that are never moved, so pointers to objects stay valid until the
+ * object is erased, and erased slots are reused before new chunks are made.
+ * Erasing bumps the slot's generation, which invalidates old handles.
+ */
+template <typename T, size_t ChunkSize = 256>
+class Pool {
+  struct Slot {
+    alignas(T) unsigned char storage[sizeof(T)];
+    uint32_t generation = 0;
+    bool alive = false;
+
+    T* get() {
+      return std::launder(reinterpret_cast<T*>(this->storage));
+    }
+  };
+
+public:
+  Pool() = default;
+  Pool(const Pool&) = delete;
+  Pool& operator=(const Pool&) = delete;
+
+  ~Pool() {
+    for (uint32_t i = 0; i < this->capacity; i++) {
+      Slot& s = this->slot(i);
+      if (s.alive) {
+        s.get()->~T();
+      }
+    }
+  }
+
+  template <typename... Args>
+  Handle<T> emplace(Args&&... args) {
+    uint32_t index;
+    if (!this->free.empty()) {
+      index = this->free.back();
+      this->free.pop_back();
+    }
+    else {
+      if (this->capacity % ChunkSize == 0) {
+        this->chunks.emplace_back(new Slot[ChunkSize]);
+      }
+      index = this->capacity++;
+    }
+
+    Slot& s = this->slot(index);
+    new (s.storage) T(std::forward<Args>(args)...);
+    s.alive = true;
+    this->count++;
+
+    return { index, s.generation };
+  }
+
+  void erase(Handle<T> handle) {
+    if (!this->contains(handle)) {
+      return;
+    }
+
+    Slot& s = this->slot(handle.index);
+    s.get()->~T();
+    s.alive = false;
+    s.generation++;
+    this->count--;
+    this->free.push_back(handle.index);
+  }
+
+  bool contains(Handle<T> handle) const {
+    if (handle.index >= this->capacity) {
+      return false;
+    }
+    const Slot& s = this->slot(handle.index);
+    return s.alive && s.generation == handle.generation;
+  }
+
+  /* Null for stale handles */
+  T* get(Handle<T> handle) {
+    return this->contains(handle) ? this->slot(handle.index).get() : nullptr;
+  }
+
+  T& operator[](Handle<T> handle) {
+    assert(this->contains(handle));
+    return *this->slot(handle.index).get();
+  }
+
+  size_t size() const {
+    return this->count;
+  }
+
+  /* Visits live objects in slot order */
+  template <typename F>
+  void forEach(F visit) {
+    for (uint32_t i = 0; i < this->capacity; i++) {
+      Slot& s = this->slot(i);
+      if (s.alive) {
+        visit(*s.get());
+      }
+    }
+  }
+
+private:
+  Slot& slot(uint32_t index) {
+    return this->chunks[index / ChunkSize][index % ChunkSize];
+  }
+
+  const Slot& slot(uint32_t index) const {
+    return this->chunks[index / ChunkSize][index % ChunkSize];
+  }
+
+  std::vector<std::unique_ptr<Slot[]>> chunks;
+  std::vector<uint32_t> free;
+  uint32_t capacity = 0;
+  size_t count = 0;
+};
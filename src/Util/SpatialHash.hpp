@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Util/Hash.hpp>
+
+/*
+ * Uniform grid of points bucketed by cell. Items only move between buckets
+ * when they cross a cell border, and neighbourhood queries visit the 3x3
+ * cells around a point, so with cellSize at least the query radius every
+ * item within that radius is visited.
+ */
+template <typename T>
+class SpatialHash {
+  using Cell = std::pair<int32_t, int32_t>;
+public:
+  explicit SpatialHash(float cellSize)
+    : cellSize { cellSize }
+  { }
+
+  /* Inserts item or moves it to the cell of position */
+  void update(T item, glm::vec2 position) {
+    Cell c = this->cell(position);
+
+    auto it = this->items.find(item);
+    if (it != this->items.end()) {
+      if (it->second == c) {
+        return;
+      }
+      this->unlink(item, it->second);
+      it->second = c;
+    }
+    else {
+      this->items.emplace(item, c);
+    }
+
+    this->cells[c].push_back(item);
+  }
+
+  void remove(T item) {
+    auto it = this->items.find(item);
+    if (it != this->items.end()) {
+      this->unlink(item, it->second);
+      this->items.erase(it);
+    }
+  }
+
+  /* Visits every item in the cells around position, including position's own */
+  template <typename F>
+  void query(glm::vec2 position, F visit) const {
+    Cell center = this->cell(position);
+
+    for (int32_t dy = -1; dy <= 1; dy++) {
+      for (int32_t dx = -1; dx <= 1; dx++) {
+        auto it = this->cells.find({ center.first + dx, center.second + dy });
+        if (it == this->cells.end()) {
+          continue;
+        }
+        for (T item : it->second) {
+          visit(item);
+        }
+      }
+    }
+  }
+
+  size_t size() const {
+    return this->items.size();
+  }
+
+private:
+  Cell cell(glm::vec2 position) const {
+    return { int32_t(std::floor(position.x / this->cellSize)), int32_t(std::floor(position.y / this->cellSize)) };
+  }
+
+  void unlink(T item, Cell c) {
+    auto it = this->cells.find(c);
+    auto& bucket = it->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), item));
+    if (bucket.empty()) {
+      this->cells.erase(it);
+    }
+  }
+
+  float cellSize;
+  std::unordered_map<Cell, std::vector<T>, PairHash> cells;
+  std::unordered_map<T, Cell> items;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+/*
+ * Bounded single-producer single-consumer ring. Push and pop are wait-free,
+ * slots are allocated once up front and capacity is rounded up to a power
+ * of two. Only the producer may call push/full, only the consumer pop.
+ */
+template <typename T>
+class SpscQueue {
+public:
+  explicit SpscQueue(size_t capacity)
+    : mask { roundUp(capacity) - 1 }
+    , slots { new T[mask + 1] }
+  { }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  bool push(T&& value) {
+    size_t tail = this->tail.load(std::memory_order_relaxed);
+    if (tail - this->head.load(std::memory_order_acquire) > this->mask) {
+      return false;
+    }
+
+    this->slots[tail & this->mask] = std::move(value);
+    this->tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool push(const T& value) {
+    T copy = value;
+    return this->push(std::move(copy));
+  }
+
+  std::optional<T> pop() {
+    size_t head = this->head.load(std::memory_order_relaxed);
+    if (head == this->tail.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+
+    std::optional<T> value { std::move(this->slots[head & this->mask]) };
+    this->head.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  /*
+   * Calls visit(T&) on up to limit elements queued when the call started,
+   * then releases them all at once. Consumer only, visit may move from them.
+   */
+  template <typename F>
+  size_t drain(F&& visit, size_t limit = SIZE_MAX) {
+    size_t head = this->head.load(std::memory_order_relaxed);
+    size_t tail = this->tail.load(std::memory_order_acquire);
+    if (tail - head > limit) {
+      tail = head + limit;
+    }
+
+    for (size_t i = head; i != tail; i++) {
+      visit(this->slots[i & this->mask]);
+    }
+
+    this->head.store(tail, std::memory_order_release);
+    return tail - head;
+  }
+
+  /* Exact for the producer, the consumer can only make room */
+  bool full() const {
+    return this->tail.load(std::memory_order_relaxed) - this->head.load(std::memory_order_acquire) > this->mask;
+  }
+
+  /* Exact for the consumer, the producer can only add more */
+  bool empty() const {
+    return this->head.load(std::memory_order_relaxed) == this->tail.load(std::memory_order_acquire);
+  }
+
+  /* Approximate unless called from the producer or consumer with the other idle */
+  size_t size() const {
+    return this->tail.load(std::memory_order_acquire) - this->head.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const {
+    return this->mask + 1;
+  }
+
+private:
+  static size_t roundUp(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  const size_t mask;
+  std::unique_ptr<T[]> slots;
+
+  /* Kept on separate cache lines so producer and consumer don't false share */
+  alignas(64) std::atomic<size_t> head { 0 };
+  alignas(64) std::atomic<size_t> tail { 0 };
+};
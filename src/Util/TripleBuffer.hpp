@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Lock-free triple buffer for one writer and one reader. The writer fills
+ * the back slot and publishes it by swapping it with the middle slot, the
+ * reader takes the middle slot whenever a newer one was published. The
+ * reader always sees the latest complete value and never blocks the writer.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+  TripleBuffer() = default;
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  /* Writer side */
+  T& back() {
+    return this->slots[this->backIndex];
+  }
+
+  void publish() {
+    this->backIndex = this->middle.exchange(this->backIndex | fresh, std::memory_order_acq_rel) & index;
+  }
+
+  void publish(T value) {
+    this->back() = std::move(value);
+    this->publish();
+  }
+
+  /* Reader side, the value stays valid until the next call */
+  const T& latest() {
+    if (this->middle.load(std::memory_order_relaxed) & fresh) {
+      this->frontIndex = this->middle.exchange(this->frontIndex, std::memory_order_acq_rel) & index;
+    }
+    return this->slots[this->frontIndex];
+  }
+
+private:
+  static constexpr uint8_t index = 0x03;
+  static constexpr uint8_t fresh = 0x04;
+
+  T slots[3] {};
+  std::atomic<uint8_t> middle { 0 };
+  uint8_t backIndex = 1;
+  uint8_t frontIndex = 2;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/* Dense per-family type ids, assigned on first use and stable for the whole run */
+template <typename Family>
+class TypeIndex {
+public:
+  template <typename T>
+  static size_t of() {
+    static const size_t id = next++;
+    return id;
+  }
+
+private:
+  static inline std::atomic<size_t> next { 0 };
+};
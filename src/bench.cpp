@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <Foundation/Infrastructures/Ropes.hpp>
+#include <Foundation/Systems/Corruption.hpp>
+
+/*
+ * Microbenchmarks for hot kernels, without a window or universe.
+ *
+ *   Constellation_Bench [iterations]
+ */
+namespace {
+  void benchCorruption(size_t iterations) {
+    constexpr uint32_t width = 640;
+    constexpr uint32_t height = 480;
+    constexpr uint32_t chunk = 256;
+    const Philox random { 0x5eed };
+    const uint32_t threshold = uint32_t(0.01 * 4294967296.0);
+
+    std::vector<uint32_t> in(width * height, 0xFF336699u);
+    std::vector<uint32_t> reference(in.size());
+    std::vector<uint32_t> out(in.size());
+
+    fmt::print("Video corruption, {}x{} frame, 1% error rate\n", width, height);
+
+    auto kernels = corruptionKernels();
+    for (const CorruptionKernel* kernel : kernels) {
+      auto frame = [&](std::vector<uint32_t>& dst, uint64_t tick) {
+        uint32_t hits = 0;
+        for (size_t base = 0; base < in.size(); base += chunk) {
+          uint32_t count = uint32_t(std::min<size_t>(chunk, in.size() - base));
+          hits += kernel->run(random, { uint32_t(base / 2), 7, tick, threshold }, in.data() + base, dst.data() + base, count);
+        }
+        return hits;
+      };
+
+      auto start = std::chrono::steady_clock::now();
+      uint64_t hits = 0;
+      for (size_t i = 0; i < iterations; i++) {
+        hits += frame(out, i);
+      }
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+      /* Every kernel must reproduce the scalar one bit for bit */
+      frame(out, 0);
+      if (kernel == kernels.front()) {
+        reference = out;
+      }
+
+      double pixels = double(in.size()) * iterations;
+      fmt::print("  {:<8} {:8.1f} Mpixel/s  {:6.3f} ms/frame  {:.3f}% hit  {}\n",
+                 kernel->isa, pixels / elapsed.count() / 1e6, elapsed.count() * 1e3 / iterations,
+                 100.0 * hits / pixels, out == reference ? "ok" : "MISMATCH");
+    }
+  }
+
+  /* Ropes on a grid with one end circling, so no rope ever falls asleep */
+  void benchRopes(size_t iterations) {
+    constexpr uint32_t ropes = 4096;
+    constexpr uint32_t columns = 64;
+    constexpr float dt = 1.0f / 60.0f;
+
+    RopeSimulation simulation;
+    std::vector<RopeSimulation::Obstacle> obstacles;
+    for (uint32_t i = 0; i < 32; i++) {
+      obstacles.push_back({ glm::vec2 { float(i % 8) * 80.0f, float(i / 8) * 60.0f + 30.0f }, 8.0f });
+    }
+
+    auto anchor = [&](uint32_t r) {
+      return glm::vec2 { float(r % columns) * 10.0f, float(r / columns) * 4.0f };
+    };
+    for (uint32_t r = 0; r < ropes; r++) {
+      simulation.add(anchor(r), anchor(r) + glm::vec2 { 40.0f, 0.0f }, 60.0f);
+    }
+
+    fmt::print("Ropes, {} ropes x {} points, {} iterations, {} obstacles\n",
+               ropes, RopeSimulation::points, RopeSimulation::iterations, obstacles.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      glm::vec2 swing { 20.0f * std::cos(i * dt * 3.0f), 20.0f * std::sin(i * dt * 3.0f) };
+      for (uint32_t r = 0; r < ropes; r++) {
+        simulation.pin(r, anchor(r), anchor(r) + glm::vec2 { 40.0f, 0.0f } + swing);
+      }
+      simulation.step(dt, obstacles);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double perStep = elapsed.count() * 1e3 / iterations;
+    fmt::print("  {:8.3f} ms/step  {:8.1f} Mrope-steps/s  {:5.1f}% of a 60 Hz frame\n",
+               perStep, ropes * iterations / elapsed.count() / 1e6, perStep / (1000.0 / 60.0) * 100.0);
+
+    /* Once the pins stop moving every rope settles and steps cost nothing */
+    for (size_t i = 0; i < 600 && !simulation.asleep(); i++) {
+      simulation.step(dt, obstacles);
+    }
+    fmt::print("  settled: {}\n", simulation.asleep() ? "yes" : "no");
+  }
+}
+
+int main(int argc, char** argv) {
+  size_t iterations = argc > 1 ? std::stoul(argv[1]) : 200;
+
+  benchCorruption(iterations);
+  benchRopes(iterations);
+
+  return 0;
+}
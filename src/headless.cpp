@@ -0,0 +1,51 @@
+#include <chrono>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <Foundation/Universe.hpp>
+#include <Foundation/Scenario.hpp>
+
+/*
+ * Runs a scenario without a window, GL context or ImGui frame, ticking the
+ * universe with a fixed time step as fast as possible.
+ *
+ *   Constellation_Headless <scenario.json> [ticks]
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fmt::print("Usage: {} <scenario.json> [ticks]\n", argv[0]);
+    return 1;
+  }
+
+  size_t ticks = argc > 2 ? std::stoul(argv[2]) : 10000;
+  const auto step = std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(1000000 / 60));
+
+  Universe universe;
+
+  try {
+    loadScenario(universe, argv[1]);
+  }
+  catch (std::exception& e) {
+    fmt::print("{}\n", e.what());
+    return 1;
+  }
+
+  /* Main loop */
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < ticks; i++) {
+    universe.tick(step);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  using ms = std::chrono::duration<double, std::milli>;
+  auto stats = universe.pool.statistics();
+  double jobs = std::max<double>(stats.jobs, 1.0);
+
+  fmt::print("Ticks: {} in {:.3f} s ({:.1f} ticks/s)\n", ticks, elapsed.count(), ticks / elapsed.count());
+  fmt::print("Components: {}, connections: {}\n", universe.components.size(), universe.connections.size());
+  fmt::print("Worker pool: {} jobs, {:.4f} ms avg queue wait, {:.4f} ms avg run time\n",
+             stats.jobs, ms(stats.queueWait).count() / jobs, ms(stats.runTime).count() / jobs);
+
+  return 0;
+}
@@ -35,329 +35,18 @@
 #include <Foundation/Systems/Video.hpp>
 #include <Foundation/Systems/Energy.hpp>
 #include <Foundation/Systems/Text.hpp>
+#include <Foundation/Systems/Data.hpp>
 #include <Foundation/Components/CPU.hpp>
 #include <Foundation/Components/Terminal.hpp>
+#include <Foundation/Components/Monitor.hpp>
+#include <Foundation/Components/Camera.hpp>
+#include <Foundation/Components/Generator.hpp>
+#include <Foundation/Components/Lamp.hpp>
+#include <Foundation/Components/Splitter.hpp>
+#include <Foundation/Components/Switch.hpp>
 
 #include <json.hpp>
 
-class Monitor : public Component {
-public:
-  explicit Monitor(Universe* w)
-    : Component(w)
-  {
-    this->addPort("video", new Antenna(200.0f, 42.0f, Capabilities {
-        .video = { true, 0.0f },
-        .energy = { false, 0.0f },
-        .text = { false },
-    }));
-
-    this->addPort("data", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { false, 0.0f },
-        .text = { true },
-    }));
-
-    this->addPort("energy", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 10.0f },
-        .text = { false },
-    }));
-
-    this->debugger.addCommand("clear", [this] {
-      messages.clear();
-    });
-  }
-
-  void update() override {
-    Component::update();
-
-    if (auto data = this->universe->system<VideoSystem>().receive(port("video"))) {
-      this->color = *data;
-    }
-    else {
-      this->color = glm::vec3 { 0.0f, 0.0f, 0.0f };
-    }
-
-    while (auto msg = this->universe->system<TextSystem>().receive(port("data"))) {
-      this->messages.push_back(*msg);
-    }
-  }
-
-  void render() override {
-    ImGui::PushStyleColor(ImGuiCol_WindowBg, (ImU32)ImColor(color.r, color.g, color.b));
-    ImGui::SetNextWindowContentSize({ 128, 128 });
-    ImGui::Begin("Monitor", nullptr, ImGuiWindowFlags_NoResize);
-    for (auto& msg : messages) {
-      ImGui::Text("%s", msg.c_str());
-    }
-    ImGui::End();
-    ImGui::PopStyleColor();
-  }
-
-  std::string name() const override {
-    return "monitor";
-  }
-
-  std::string defaultPort() const override {
-    return "data";
-  }
-
-  glm::vec3 color;
-  std::vector<std::string> messages;
-};
-
-class Camera : public Component {
-public:
-  explicit Camera(Universe* w)
-    : Component(w)
-  {
-    addPort("video", new Antenna(100.0f, 40.0f, Capabilities {
-        .video = { true, 0.0f },
-        .energy = { false, 0.0f },
-        .text = { false },
-    }));
-
-    addPort("energy", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 10.0f },
-        .text = { false },
-    }));
-
-    debugger.addCommand("set_color", [this](float r, float g, float b) {
-      color = { r, g, b };
-    });
-
-    debugger.addCommand("get_color", [this]() {
-      return fmt::format("{} {} {}", color.r, color.g, color.b);
-    });
-
-    debugger.addCommand("set_freq", [this](float f) {
-      auto* a = dynamic_cast<Antenna*>(port("video"));
-      a->frequency = f;
-    });
-
-    debugger.addCommand("get_freq", [this]() {
-      auto* a = dynamic_cast<Antenna*>(port("video"));
-      return fmt::format("{}", a->frequency);
-    });
-  }
-
-  void update() override {
-    Component::update();
-
-    universe->system<VideoSystem>().send(port("video"), color);
-  }
-
-  void render() override {
-    auto* a = dynamic_cast<Antenna*>(port("video"));
-
-    ImGui::SetNextWindowSize({ 256, 0 });
-    ImGui::Begin("Camera");
-    ImGui::ColorPicker3("Color", (float*)&color);
-    ImGui::SliderFloat("Frequency", &a->frequency, 40.0f, 50.0f);
-    ImGui::End();
-  }
-
-  std::string name() const override {
-    return "camera";
-  }
-
-  std::string defaultPort() const override {
-    return "video";
-  }
-
-  glm::vec3 color;
-};
-
-class Generator : public Component {
-public:
-  explicit Generator(Universe* w)
-    : Component(w)
-    , history(256, 0)
-  {
-    addPort("energy", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 100.0f },
-        .text = { true }
-    }));
-  }
-
-  void update() override {
-    Component::update();
-
-    noise = (randomFloat() - 0.5f) * 10.0f;
-    this->universe->system<EnergySystem>().produce(port("energy"), power + noise);
-    history.push_back(power + noise);
-  }
-
-  void render() override {
-    ImGui::SetNextWindowSize({ 256.0f, 0.0f });
-    ImGui::Begin("Generator");
-
-    ImGui::PushItemWidth(-1);
-    ImGui::SliderFloat("##power", &power, 0.0f, 100.0f);
-    ImGui::PopItemWidth();
-
-    while (history.size() > 256) {
-      history.erase(history.begin());
-    }
-    ImGui::PushItemWidth(-1);
-    ImGui::PlotLines("##history", history.data(), history.size(), 0, nullptr, 0.0f, 100.0f);
-    ImGui::PopItemWidth();
-
-    ImGui::End();
-  }
-
-  std::string name() const override {
-    return "generator";
-  }
-
-  std::string defaultPort() const override {
-    return "energy";
-  }
-
-  float power = 50.0f;
-  float noise = 0.0f;
-  std::vector<float> history;
-};
-
-class Lamp : public Component {
-public:
-  explicit Lamp(Universe* w)
-    : Component(w)
-    , id { ++counter }
-  {
-    addPort("energy", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 10.0f },
-        .text = { true },
-    }));
-  }
-
-  void update() override {
-    Component::update();
-
-    float energy = this->universe->system<EnergySystem>().consume(port("energy"), 10.0f);
-    satisfaction = energy / 10.0f;
-  }
-
-  void render() override {
-    ImGui::PushStyleColor(ImGuiCol_WindowBg, (ImU32)ImColor(satisfaction, satisfaction, 0.0f));
-    ImGui::SetNextWindowContentSize({ 64, 64 });
-    ImGui::Begin(name().c_str(), nullptr, ImGuiWindowFlags_NoResize);
-    ImGui::End();
-    ImGui::PopStyleColor();
-  }
-
-  std::string name() const override {
-    return fmt::format("lamp{}", id);
-  }
-
-  std::string defaultPort() const override {
-    return "energy";
-  }
-
-  float satisfaction = 0.0f;
-
-  static inline size_t counter = 0;
-  size_t id = 0;
-};
-
-class Splitter : public Component {
-public:
-  explicit Splitter(Universe* u)
-    : Component(u)
-  {
-    addPort("a", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 20.0f },
-        .text = { false },
-    }));
-
-    addPort("b", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 20.0f },
-        .text = { false },
-    }));
-
-    addPort("c", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 20.0f },
-        .text = { false },
-    }));
-  }
-
-  void render() override { }
-
-  std::vector<std::pair<float, Endpoint*>> redistributeEnergy(Endpoint* p) override {
-    std::vector<std::pair<float, Endpoint*>> neighbours;
-
-    if (p != port("a")) { neighbours.emplace_back(0.5f, port("a")); }
-    if (p != port("b")) { neighbours.emplace_back(0.5f, port("b")); }
-    if (p != port("c")) { neighbours.emplace_back(0.5f, port("c")); }
-
-    return neighbours;
-  }
-
-  std::string name() const override {
-    return "splitter";
-  }
-
-  std::string defaultPort() const override {
-    return "a";
-  }
-};
-
-class Switch : public Component {
-public:
-  explicit Switch(Universe* u)
-    : Component(u)
-  {
-    addPort("a", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 20.0f },
-        .text = { false },
-    }));
-
-    addPort("b", this->universe->infrastructure<Wiring>().createSocket(Capabilities {
-        .video = { false, 0.0f },
-        .energy = { true, 20.0f },
-        .text = { false },
-    }));
-
-    debugger.addCommand("toggle", [this] {
-      toggle = !toggle;
-    });
-  }
-
-  void render() override {
-    ImGui::Begin("Switch");
-    ImGui::Checkbox("Toggle", &toggle);
-    ImGui::End();
-  }
-
-  std::vector<std::pair<float, Endpoint*>> redistributeEnergy(Endpoint* p) override {
-    std::vector<std::pair<float, Endpoint*>> neighbours;
-
-    if (toggle) {
-      if (p != port("a")) { neighbours.emplace_back(1.0f, port("a")); }
-      if (p != port("b")) { neighbours.emplace_back(1.0f, port("b")); }
-    }
-
-    return neighbours;
-  }
-
-  std::string name() const override {
-    return "switch";
-  }
-
-  std::string defaultPort() const override {
-    return "a";
-  }
-
-  bool toggle = true;
-};
-
 class Door : public Component {
 public:
   explicit Door(Universe* u)
@@ -401,7 +90,6 @@ void DrawGraph(Universe& universe) {
     if (component->position == glm::vec2 { 0.0f, 0.0f }) {
       glm::vec2 size { window->Size.x, window->Size.y };
       glm::vec2 padding = 0.1f * size;
-      component->position = padding + (size - 2.0f * padding) * glm::vec2 { randomFloat(), randomFloat() };
 
       int i = 0;
       for (auto& pair : component->ports) {
@@ -410,6 +98,8 @@ void DrawGraph(Universe& universe) {
         Endpoint* p = pair.second.get();
         p->position = glm::vec2 { glm::sin(d), glm::cos(d) } * 12.0f;
       }
+
+      component->move(padding + (size - 2.0f * padding) * glm::vec2 { randomFloat(), randomFloat() });
     }
   }
 
@@ -469,7 +159,7 @@ void DrawGraph(Universe& universe) {
     }
 
     if (active == c.get()) {
-      c->position += glm::vec2 { ImGui::GetIO().MouseDelta.x, ImGui::GetIO().MouseDelta.y };
+      c->move(c->position + glm::vec2 { ImGui::GetIO().MouseDelta.x, ImGui::GetIO().MouseDelta.y });
     }
   }
 
@@ -478,26 +168,30 @@ void DrawGraph(Universe& universe) {
 
   static Connector* activeC = nullptr;
   if (!ImGui::IsMouseDown(0) && activeC != nullptr) {
-    activeC->magnetic = false;
+    wiring.setMagnetic(activeC, false);
     activeC = nullptr;
   }
 
-  for (auto& cable : wiring.cables) {
-    ImVec2 aPos = offset + cable->a.position();
-    ImVec2 bPos = offset + cable->b.position();
+  wiring.cables.forEach([&](Cable& cable) {
+    ImVec2 aPos = offset + cable.a.position();
+    ImVec2 bPos = offset + cable.b.position();
 
-    window->DrawList->AddLine(aPos, bPos, red, 2.0f);
+    for (uint32_t i = 0; i + 1 < RopeSimulation::points; i++) {
+      ImVec2 from = offset + wiring.ropes.point(cable.rope, i);
+      ImVec2 to = offset + wiring.ropes.point(cable.rope, i + 1);
+      window->DrawList->AddLine(from, to, red, 2.0f);
+    }
     window->DrawList->AddCircleFilled(aPos, 2.0f, white);
 
     ImGui::SetCursorScreenPos(aPos - ImVec2 { 3.0f, 3.0f });
     ImGui::InvisibleButton("##a", { 6.0f, 6.0f });
     if (ImGui::IsItemClicked(0)) {
-      activeC = &cable->a;
-      activeC->magnetic = true;
+      activeC = &cable.a;
+      wiring.setMagnetic(activeC, true);
     }
     if (ImGui::IsItemClicked(1)) {
-      if (cable->a.other) {
-        wiring.separate(&cable->a, cable->a.other);
+      if (cable.a.other) {
+        wiring.separate(&cable.a, cable.a.other);
       }
     }
 
@@ -506,19 +200,19 @@ void DrawGraph(Universe& universe) {
     ImGui::SetCursorScreenPos(bPos - ImVec2 { 3.0f, 3.0f });
     ImGui::InvisibleButton("##b", { 6.0f, 6.0f });
     if (ImGui::IsItemClicked(0)) {
-      activeC = &cable->b;
-      activeC->magnetic = true;
+      activeC = &cable.b;
+      wiring.setMagnetic(activeC, true);
     }
     if (ImGui::IsItemClicked(1)) {
-      if (cable->b.other) {
-        wiring.separate(&cable->b, cable->b.other);
+      if (cable.b.other) {
+        wiring.separate(&cable.b, cable.b.other);
       }
     }
 
-    if (activeC == &cable->a || activeC == &cable->b) {
+    if (activeC == &cable.a || activeC == &cable.b) {
       activeC->position() += glm::vec2 { ImGui::GetIO().MouseDelta.x, ImGui::GetIO().MouseDelta.y };
     }
-  }
+  });
 
   if (ImGui::IsWindowHovered() && !ImGui::IsAnyItemActive() && ImGui::IsMouseDragging(2, 0.0f)) {
     scrolling -= ImGui::GetIO().MouseDelta;
@@ -539,6 +233,22 @@ void SystemUI(Universe& universe) {
     }
   }
 
+  if (ImGui::TreeNode("Worker pool")) {
+    using ms = std::chrono::duration<float, std::milli>;
+    auto stats = universe.pool.statistics();
+    float jobs = std::max<float>(stats.jobs, 1.0f);
+
+    ImGui::Text("Threads: %zu", universe.pool.size());
+    ImGui::Text("Jobs: %llu", (unsigned long long)stats.jobs);
+    ImGui::Text("Queue wait: %.3f ms avg, %.3f ms max",
+                ms(stats.queueWait).count() / jobs, ms(stats.maxQueueWait).count());
+    ImGui::Text("Run time: %.3f ms avg", ms(stats.runTime).count() / jobs);
+    if (ImGui::Button("Reset")) {
+      universe.pool.resetStatistics();
+    }
+    ImGui::TreePop();
+  }
+
   ImGui::End();
 }
 
@@ -592,6 +302,7 @@ int main() {
   universe.add<VideoSystem>();
   universe.add<EnergySystem>();
   universe.add<TextSystem>();
+  universe.add<DataSystem>();
 
   universe.add<Monitor>();
   universe.add<Camera>();